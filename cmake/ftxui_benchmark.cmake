@@ -8,10 +8,13 @@ endif()
 include(cmake/ftxui_find_google_benchmark.cmake)
 
 add_executable(ftxui-benchmark
+  src/ftxui/component/benchmark_test.cpp
   src/ftxui/dom/benchmark_test.cpp
+  src/ftxui/screen/benchmark_test.cpp
   )
 ftxui_set_options(ftxui-benchmark)
 target_link_libraries(ftxui-benchmark
+  PRIVATE component
   PRIVATE dom
   PRIVATE benchmark::benchmark
   PRIVATE benchmark::benchmark_main
@@ -59,6 +59,8 @@ function(ftxui_set_options library)
       target_compile_options(${library} PRIVATE "/wd4244")
       target_compile_options(${library} PRIVATE "/wd4267")
       target_compile_options(${library} PRIVATE "/D_CRT_SECURE_NO_WARNINGS")
+      # The Unicode tables are compiled from the intervals at compile time.
+      target_compile_options(${library} PRIVATE "/constexpr:steps10000000")
     endif()
     # Force Win32 to UNICODE
     target_compile_definitions(${library} PRIVATE UNICODE _UNICODE)
@@ -31,13 +31,18 @@ add_executable(ftxui-tests
   src/ftxui/dom/color_test.cpp
   src/ftxui/dom/dbox_test.cpp
   src/ftxui/dom/dim_test.cpp
+  src/ftxui/dom/element_arena_test.cpp
   src/ftxui/dom/flexbox_helper_test.cpp
   src/ftxui/dom/flexbox_test.cpp
   src/ftxui/dom/gauge_test.cpp
   src/ftxui/dom/gridbox_test.cpp
   src/ftxui/dom/hbox_test.cpp
   src/ftxui/dom/hyperlink_test.cpp
+  src/ftxui/dom/layer_test.cpp
   src/ftxui/dom/linear_gradient_test.cpp
+  src/ftxui/dom/memo_test.cpp
+  src/ftxui/dom/node_test.cpp
+  src/ftxui/dom/paragraph_test.cpp
   src/ftxui/dom/scroll_indicator_test.cpp
   src/ftxui/dom/separator_test.cpp
   src/ftxui/dom/spinner_test.cpp
@@ -45,8 +50,12 @@ add_executable(ftxui-tests
   src/ftxui/dom/text_test.cpp
   src/ftxui/dom/underlined_test.cpp
   src/ftxui/dom/vbox_test.cpp
+  src/ftxui/dom/virtual_list_test.cpp
   src/ftxui/screen/color_test.cpp
+  src/ftxui/screen/grapheme_test.cpp
+  src/ftxui/screen/screen_test.cpp
   src/ftxui/screen/string_test.cpp
+  src/ftxui/screen/terminal_test.cpp
 )
 
 target_link_libraries(ftxui-tests
@@ -5,9 +5,10 @@
 #define FTXUI_COMPONENT_SCREEN_INTERACTIVE_HPP
 
 #include <atomic>                        // for atomic
+#include <cstddef>                       // for size_t
 #include <ftxui/component/receiver.hpp>  // for Receiver, Sender
 #include <functional>                    // for function
-#include <memory>                        // for shared_ptr
+#include <memory>                        // for shared_ptr, unique_ptr
 #include <string>                        // for string
 #include <thread>                        // for thread
 #include <variant>                       // for variant
@@ -16,6 +17,7 @@
 #include "ftxui/component/captured_mouse.hpp"  // for CapturedMouse
 #include "ftxui/component/event.hpp"           // for Event
 #include "ftxui/component/task.hpp"            // for Task, Closure
+#include "ftxui/dom/element_arena.hpp"         // for ElementArena
 #include "ftxui/screen/screen.hpp"             // for Screen
 
 namespace ftxui {
@@ -36,6 +38,11 @@ class ScreenInteractive : public Screen {
 
   // Options. Must be called before Loop().
   void TrackMouse(bool enable = true);
+  void DifferentialOutput(bool enable = true);
+  void SynchronizedUpdate(bool enable = true);
+  void CompressOutput(bool enable = true);
+  void ReserveSize(int dimx, int dimy);
+  void UseElementArena(bool enable = true);
 
   // Return the currently active screen, nullptr if none.
   static ScreenInteractive* Active();
@@ -57,6 +64,16 @@ class ScreenInteractive : public Screen {
   // temporarily uninstalled.
   Closure WithRestoredIO(Closure);
 
+  // Statistics about the output sent to the terminal.
+  struct Stats {
+    int frame_count = 0;
+    size_t bytes_last_frame = 0;
+    size_t bytes_total = 0;
+    int writes_last_frame = 0;  // Number of write calls used.
+    size_t writes_total = 0;
+  };
+  const Stats& stats() const { return stats_; }
+
  private:
   void ExitNow();
 
@@ -91,6 +108,14 @@ class ScreenInteractive : public Screen {
                     bool use_alternative_screen);
 
   bool track_mouse_ = true;
+  bool differential_output_ = false;
+  bool synchronized_update_ = false;
+  OutputOptions output_options_;
+
+  // The last frame sent to the terminal. Used by the differential output.
+  Screen previous_frame_ = Screen(0, 0);
+
+  Stats stats_;
 
   Sender<Task> task_sender_;
   Receiver<Task> task_receiver_;
@@ -98,6 +123,12 @@ class ScreenInteractive : public Screen {
   std::string set_cursor_position;
   std::string reset_cursor_position;
 
+  // The encoded frame. Reused in between frames to avoid allocations.
+  std::string output_buffer_;
+
+  // Where the elements of a frame are allocated. See UseElementArena().
+  std::unique_ptr<ElementArena> element_arena_;
+
   std::atomic<bool> quit_ = false;
   std::thread event_listener_;
   std::thread animation_listener_;
@@ -0,0 +1,103 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_ELEMENT_ARENA_HPP
+#define FTXUI_DOM_ELEMENT_ARENA_HPP
+
+#include <cstddef>  // for size_t, max_align_t
+#include <memory>   // for allocate_shared, make_shared, shared_ptr
+#include <utility>  // for forward
+#include <vector>   // for vector
+
+namespace ftxui {
+
+/// @brief Memory where the elements are allocated, instead of the heap, while
+/// it is in use. The elements of a frame are allocated one after the other, and
+/// the memory is reused for the next frame, once they are destroyed.
+///
+/// The elements still alive, for instance kept by `memo`, keep their memory
+/// until they are destroyed. They can outlive the arena.
+/// @ingroup dom
+class ElementArena {
+ public:
+  ElementArena();
+  ~ElementArena();
+  ElementArena(const ElementArena&) = delete;
+  ElementArena& operator=(const ElementArena&) = delete;
+
+  // Reuse the memory of the elements destroyed so far.
+  void Reset();
+
+  // The elements built on this thread are allocated in |arena| while the scope
+  // exists. A null |arena| uses the heap.
+  class Scope {
+   public:
+    explicit Scope(ElementArena* arena);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    ElementArena* previous_;
+  };
+
+  // The arena in use on this thread, or nullptr.
+  static ElementArena* Current();
+
+  // Used by ElementAllocator.
+  void* Allocate(size_t size);
+  static void Deallocate(void* pointer);
+
+ private:
+  struct Block;
+  std::vector<Block*> blocks_;
+  size_t current_ = 0;
+};
+
+// Allocate from an ElementArena, for std::allocate_shared.
+template <typename T>
+struct ElementAllocator {
+  using value_type = T;
+
+  explicit ElementAllocator(ElementArena* arena) : arena(arena) {}
+  template <typename U>
+  ElementAllocator(const ElementAllocator<U>& other)  // NOLINT
+      : arena(other.arena) {}
+
+  T* allocate(size_t n) {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "Over-aligned types can't be allocated in an ElementArena.");
+    return static_cast<T*>(arena->Allocate(n * sizeof(T)));
+  }
+  void deallocate(T* pointer, size_t /* n */) {
+    ElementArena::Deallocate(pointer);
+  }
+
+  template <typename U>
+  bool operator==(const ElementAllocator<U>& other) const {
+    return arena == other.arena;
+  }
+  template <typename U>
+  bool operator!=(const ElementAllocator<U>& other) const {
+    return arena != other.arena;
+  }
+
+  ElementArena* arena;
+};
+
+/// @brief Create a node, in the ElementArena in use if any. Otherwise, this is
+/// the same as std::make_shared.
+/// @ingroup dom
+template <typename T, typename... Args>
+std::shared_ptr<T> MakeElement(Args&&... args) {
+  ElementArena* arena = ElementArena::Current();
+  if (arena == nullptr) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+  return std::allocate_shared<T>(ElementAllocator<T>(arena),
+                                 std::forward<Args>(args)...);
+}
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_ELEMENT_ARENA_HPP
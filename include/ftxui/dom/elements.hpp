@@ -167,6 +167,15 @@ Element yframe(Element);
 Element focus(Element);
 Element select(Element);
 
+// A list of rows inside a frame. Only the visible rows are built, using
+// |build|. The |focused| row is built during the layout to scroll to it. The
+// list is as wide as the |focused| row, or the first one: the wider rows are
+// clipped.
+Element virtualList(int count,
+                    int row_height,
+                    std::function<Element(int)> build,
+                    int focused = -1);
+
 // --- Cursor ---
 // Those are similar to `focus`, but also change the shape of the cursor.
 Element focusCursorBlock(Element);
@@ -183,6 +192,30 @@ Decorator reflect(Box& box);
 // combinaison with dbox.
 Element clear_under(Element element);
 
+// --- Memoization ---
+// Where a `memo` element is kept in between frames.
+struct MemoKey {
+  int version = 0;
+  Element element;
+};
+// Reuse the element built by |builder| and its layout, for as long as
+// |version| is unchanged.
+Element memo(MemoKey& key,
+             int version,
+             const std::function<Element()>& builder);
+
+// --- Layer ---
+// Where the pixels of a `layer` are kept in between frames.
+struct LayerKey {
+  int version = 0;
+  bool drawn = false;
+  Requirement requirement;
+  Screen pixels = Screen(0, 0);
+};
+// Draw the element once, and copy its pixels for as long as |version| and its
+// size are unchanged.
+Decorator layer(LayerKey& key, int version);
+
 // --- Util --------------------------------------------------------------------
 Element hcenter(Element);
 Element vcenter(Element);
@@ -4,8 +4,9 @@
 #ifndef FTXUI_DOM_NODE_HPP
 #define FTXUI_DOM_NODE_HPP
 
-#include <memory>  // for shared_ptr
-#include <vector>  // for vector
+#include <functional>  // for function
+#include <memory>      // for shared_ptr
+#include <vector>      // for vector
 
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
@@ -53,14 +54,29 @@ class Node {
   virtual void Check(Status* status);
 
  protected:
+  // Draw |child|, unless its box is outside of the stencil. Containers use it
+  // to skip their invisible children. A child whose box wasn't assigned by
+  // Node::SetBox() is always drawn.
+  static void RenderChild(Screen& screen, Node* child);
+
+  // Run the whole layout of |node| inside |box|, on its own. Used by the
+  // elements laying out their children again in between frames.
+  static void Layout(Node* node, Box box);
+
   Elements children_;
   Requirement requirement_;
   Box box_;
+  bool box_set_ = false;  // Whether Node::SetBox() assigned |box_|.
 };
 
 void Render(Screen& screen, const Element& element);
 void Render(Screen& screen, Node* node);
 
+// Display an element taller than the screen, a band of lines at a time.
+void RenderBands(Screen& screen,
+                 const Element& element,
+                 const std::function<void(Screen&)>& on_band);
+
 }  // namespace ftxui
 
 #endif  // FTXUI_DOM_NODE_HPP
@@ -27,6 +27,16 @@ struct Requirement {
   };
   Selection selection = NORMAL;
   Box selected_box;
+
+  bool operator==(const Requirement& other) const {
+    return min_x == other.min_x && min_y == other.min_y &&
+           flex_grow_x == other.flex_grow_x &&
+           flex_grow_y == other.flex_grow_y &&
+           flex_shrink_x == other.flex_shrink_x &&
+           flex_shrink_y == other.flex_shrink_y &&
+           selection == other.selection && selected_box == other.selected_box;
+  }
+  bool operator!=(const Requirement& other) const { return !(*this == other); }
 };
 
 }  // namespace ftxui
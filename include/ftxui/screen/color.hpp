@@ -309,6 +309,7 @@ class Color {
   bool operator!=(const Color& rhs) const;
 
   std::string Print(bool is_background_color) const;
+  void Print(std::string& out, bool is_background_color) const;
 
  private:
   enum class ColorType : uint8_t {
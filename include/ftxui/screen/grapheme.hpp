@@ -0,0 +1,157 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_SCREEN_GRAPHEME_HPP
+#define FTXUI_SCREEN_GRAPHEME_HPP
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint8_t, uint32_t
+#include <cstring>      // for memcpy
+#include <iosfwd>       // for ostream
+#include <string>       // for string
+#include <string_view>  // for string_view
+
+namespace ftxui {
+
+/// @brief The content of a Pixel: a grapheme cluster, stored in 4 bytes.
+///
+/// Graphemes whose UTF-8 encoding fits in 4 bytes, like every single
+/// codepoint, are stored inline. Longer ones, like characters followed by
+/// combining characters, are interned into a process-wide pool and only their
+/// index is stored. Interned graphemes are reference counted, and released from
+/// the pool once the last copy is gone. Reading them doesn't take any lock.
+/// When 2^24 distinct graphemes are in use, the new ones are reduced to their
+/// first codepoint.
+///
+/// Two Grapheme are equal if and only if they hold the same string.
+/// @ingroup screen
+class Grapheme {
+ public:
+  Grapheme() = default;  // A space.
+  Grapheme(std::string_view str);  // NOLINT
+  Grapheme(const std::string& str)  // NOLINT
+      : Grapheme(std::string_view(str)) {}
+  Grapheme(const char* str)  // NOLINT
+      : Grapheme(std::string_view(str)) {}
+
+  Grapheme(const Grapheme& other) {
+    other.Retain();
+    CopyData(other);
+  }
+  Grapheme(Grapheme&& other) noexcept {
+    CopyData(other);
+    other.Reset();
+  }
+  Grapheme& operator=(const Grapheme& other) {
+    other.Retain();  // First, in case of self assignment.
+    Release();
+    CopyData(other);
+    return *this;
+  }
+  Grapheme& operator=(Grapheme&& other) noexcept {
+    if (this != &other) {
+      Release();
+      CopyData(other);
+      other.Reset();
+    }
+    return *this;
+  }
+  ~Grapheme() { Release(); }
+
+  // The UTF-8 encoded string. For inline graphemes, the view points inside
+  // this object.
+  std::string_view view() const;
+  std::string str() const { return std::string(view()); }
+  operator std::string() const { return str(); }  // NOLINT
+
+  size_t size() const;
+  bool empty() const { return data_[0] == 0; }
+
+  // Like std::string::c_str(). The pointer is valid until the grapheme is
+  // modified or destroyed. Except for the inline graphemes of 4 bytes: they are
+  // copied into a buffer of the calling thread, valid until its next call.
+  const char* c_str() const;
+
+  // Append to the grapheme, for instance a combining character.
+  Grapheme& operator+=(std::string_view str);
+  Grapheme& operator+=(const std::string& str) {
+    return *this += std::string_view(str);
+  }
+  Grapheme& operator+=(const char* str) {
+    return *this += std::string_view(str);
+  }
+
+  bool operator==(const Grapheme& other) const {
+    return Code() == other.Code();
+  }
+  bool operator!=(const Grapheme& other) const { return !(*this == other); }
+
+  friend bool operator==(const Grapheme& a, const std::string& b) {
+    return a.view() == b;
+  }
+  friend bool operator==(const Grapheme& a, const char* b) {
+    return a.view() == b;
+  }
+  friend bool operator==(const std::string& a, const Grapheme& b) {
+    return b == a;
+  }
+  friend bool operator==(const char* a, const Grapheme& b) { return b == a; }
+  friend bool operator!=(const Grapheme& a, const std::string& b) {
+    return !(a == b);
+  }
+  friend bool operator!=(const Grapheme& a, const char* b) {
+    return !(a == b);
+  }
+  friend bool operator!=(const std::string& a, const Grapheme& b) {
+    return !(b == a);
+  }
+  friend bool operator!=(const char* a, const Grapheme& b) {
+    return !(b == a);
+  }
+
+ private:
+  bool IsInterned() const { return data_[0] == kInterned; }
+  uint32_t Id() const { return Code() >> 8U; }  // NOLINT
+
+  void CopyData(const Grapheme& other) {
+    std::memcpy(data_, other.data_, sizeof(data_));  // NOLINT
+  }
+  void Reset() {
+    data_[0] = ' ';  // NOLINT
+    data_[1] = 0;    // NOLINT
+    data_[2] = 0;    // NOLINT
+    data_[3] = 0;    // NOLINT
+  }
+
+  // Only the interned graphemes are reference counted, out of line.
+  void Retain() const {
+    if (IsInterned()) {
+      RetainInterned(Id());
+    }
+  }
+  void Release() {
+    if (IsInterned()) {
+      ReleaseInterned(Id());
+    }
+  }
+  static void RetainInterned(uint32_t id);
+  static void ReleaseInterned(uint32_t id);
+
+  uint32_t Code() const {
+    return uint32_t(data_[0]) | uint32_t(data_[1]) << 8U |  // NOLINT
+           uint32_t(data_[2]) << 16U | uint32_t(data_[3]) << 24U;  // NOLINT
+  }
+
+  // 0xFF never appears in UTF-8. It tags interned graphemes, whose index into
+  // the pool is stored in the 3 other bytes.
+  static constexpr uint8_t kInterned = 0xFF;
+
+  // Byte aligned, so that Pixel is tightly packed.
+  uint8_t data_[4] = {' ', 0, 0, 0};  // NOLINT
+};
+
+std::ostream& operator<<(std::ostream& out, const Grapheme& grapheme);
+
+}  // namespace ftxui
+
+#endif  // FTXUI_SCREEN_GRAPHEME_HPP
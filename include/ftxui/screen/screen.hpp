@@ -4,17 +4,41 @@
 #ifndef FTXUI_SCREEN_SCREEN_HPP
 #define FTXUI_SCREEN_SCREEN_HPP
 
-#include <cstdint>  // for uint8_t
+#include <cstddef>  // for offsetof
+#include <cstdint>  // for uint8_t, uint16_t
+#include <cstring>  // for memcpy
 #include <memory>
 #include <string>  // for string, basic_string, allocator
+#include <type_traits>    // for is_trivially_copyable_v
+#include <unordered_map>  // for unordered_map
 #include <vector>  // for vector
 
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/color.hpp"     // for Color, Color::Default
+#include "ftxui/screen/grapheme.hpp"  // for Grapheme
 #include "ftxui/screen/terminal.hpp"  // for Dimensions
 
 namespace ftxui {
 
+/// @brief The id of a hyperlink registered in a Screen. 0 means no hyperlink.
+///
+/// This is a 16 bits integer, stored in two bytes so that Pixel is tightly
+/// packed.
+/// @ingroup screen
+class HyperlinkId {
+ public:
+  HyperlinkId() = default;
+  HyperlinkId(uint16_t id)  // NOLINT
+      : low_(uint8_t(id)), high_(uint8_t(id >> 8U)) {}  // NOLINT
+  operator uint16_t() const {  // NOLINT
+    return uint16_t(low_ | high_ << 8U);  // NOLINT
+  }
+
+ private:
+  uint8_t low_ = 0;
+  uint8_t high_ = 0;
+};
+
 /// @brief A unicode character and its associated style.
 /// @ingroup screen
 struct Pixel {
@@ -28,6 +52,22 @@ struct Pixel {
         strikethrough(false),
         automerge(false) {}
 
+  Pixel(const Pixel& other)
+      : hyperlink(other.hyperlink),
+        background_color(other.background_color),
+        foreground_color(other.foreground_color),
+        character(other.character) {
+    CopyBitField(other);
+  }
+  Pixel& operator=(const Pixel& other) {
+    if (this != &other) {
+      CopyStyle(other);
+      character = other.character;
+    }
+    return *this;
+  }
+  ~Pixel() = default;
+
   // A bit field representing the style:
   bool blink : 1;
   bool bold : 1;
@@ -40,15 +80,40 @@ struct Pixel {
 
   // The hyperlink associated with the pixel.
   // 0 is the default value, meaning no hyperlink.
-  uint8_t hyperlink = 0;
-
-  // The graphemes stored into the pixel. To support combining characters,
-  // like: a⃦, this can potentially contain multiple codepoints.
-  std::string character = " ";
+  HyperlinkId hyperlink;
 
   // Colors:
   Color background_color = Color::Default;
   Color foreground_color = Color::Default;
+
+  // The graphemes stored into the pixel. To support combining characters,
+  // like: a⃦, this can potentially contain multiple codepoints.
+  Grapheme character;
+
+ private:
+  // Copied member by member, the bits of the bit field would be copied one at
+  // a time, making Screen::Clear() 4 times slower. The copy constructor copies
+  // the byte holding them at once. The assignment copies every member before
+  // |character| at once. They are trivially copyable.
+  static constexpr size_t kStyleSize = 11;
+  void CopyBitField(const Pixel& other) {
+    static_assert(offsetof(Pixel, hyperlink) == 1,
+                  "The bit field is stored in the first byte.");
+    *reinterpret_cast<uint8_t*>(this) =            // NOLINT
+        *reinterpret_cast<const uint8_t*>(&other);  // NOLINT
+  }
+  void CopyStyle(const Pixel& other) {
+    static_assert(offsetof(Pixel, foreground_color) + sizeof(Color) ==
+                          kStyleSize &&
+                      offsetof(Pixel, character) >= kStyleSize,
+                  "The style is stored in the first bytes.");
+    static_assert(std::is_trivially_copyable_v<HyperlinkId> &&
+                      std::is_trivially_copyable_v<Color>,
+                  "The style is copied as bytes.");
+    std::memcpy(reinterpret_cast<uint8_t*>(this),          // NOLINT
+                reinterpret_cast<const uint8_t*>(&other),  // NOLINT
+                kStyleSize);
+  }
 };
 
 /// @brief Define how the Screen's dimensions should look like.
@@ -68,14 +133,45 @@ class Screen {
   static Screen Create(Dimensions width, Dimensions height);
 
   // Access a character in the grid at a given position.
-  std::string& at(int x, int y);
-  const std::string& at(int x, int y) const;
+  Grapheme& at(int x, int y);
+  const Grapheme& at(int x, int y) const;
 
   // Access a cell (Pixel) in the grid at a given position.
   Pixel& PixelAt(int x, int y);
   const Pixel& PixelAt(int x, int y) const;
 
+  // Access a row of cells (Pixel), without bounds checks.
+  Pixel* Row(int y);
+  const Pixel* Row(int y) const;
+
   std::string ToString() const;
+  std::string ToStringDiff(const Screen& previous) const;
+
+  // Same as above, but append to |out|. Reusing the same buffer in between
+  // frames avoids allocations.
+  void ToString(std::string& out) const;
+  void ToStringDiff(const Screen& previous, std::string& out) const;
+
+  // Optional terminal features, used to shrink the output.
+  struct OutputOptions {
+    bool repeat = false;      // Repeat the previous character (REP).
+    bool erase_line = false;  // Erase the trailing blank cells (EL).
+
+    // Scroll the lines that moved vertically (DECSTBM + SU/SD). Used by
+    // ToStringDiff(). This requires the screen to be displayed at the top of
+    // the terminal, like in fullscreen mode.
+    bool scroll_region = false;
+
+    // The number of threads encoding the screen, each one a band of lines.
+    // Used by ToString(). This is worth it for very large screens only. This
+    // is limited to the number of cores, and to the number of lines. The
+    // threads are kept in between calls, and joined at exit.
+    int threads = 1;
+  };
+  void ToString(std::string& out, const OutputOptions& options) const;
+  void ToStringDiff(const Screen& previous,
+                    std::string& out,
+                    const OutputOptions& options) const;
 
   // Print the Screen on to the terminal.
   void Print() const;
@@ -90,6 +186,19 @@ class Screen {
   // Fill the screen with space.
   void Clear();
 
+  // Change the dimensions of the screen, and fill it with space. The storage
+  // is reused when it is large enough.
+  void Resize(int dimx, int dimy);
+
+  // Preallocate the storage for a screen of up to |dimx| x |dimy| cells.
+  void Reserve(int dimx, int dimy);
+
+  // Whether each row was written since the last Clear(), as 0 or 1. The other
+  // rows are known to be blank. A row is marked when a mutable cell or row is
+  // handed out, even if its content is left unchanged: this tells nothing about
+  // the rows changed since the previous output.
+  const std::vector<uint8_t>& WrittenRows() const { return written_rows_; }
+
   void ApplyShader();
 
   struct Cursor {
@@ -112,17 +221,32 @@ class Screen {
 
   // Store an hyperlink in the screen. Return the id of the hyperlink. The id is
   // used to identify the hyperlink when the user click on it.
-  uint8_t RegisterHyperlink(const std::string& link);
-  const std::string& Hyperlink(uint8_t id) const;
+  uint16_t RegisterHyperlink(const std::string& link);
+  const std::string& Hyperlink(uint16_t id) const;
 
   Box stencil;
 
+  // The number of elements skipped by the last Render(), because they were
+  // outside of the stencil.
+  int culled = 0;
+
  protected:
   int dimx_;
   int dimy_;
-  std::vector<std::vector<Pixel>> pixels_;
+  std::vector<Pixel> pixels_;  // Row-major, dimx_ * dimy_ pixels.
+  // dimy_ rows. See WrittenRows(). Bytes are cheaper to set than the bits of a
+  // std::vector<bool>, in PixelAt().
+  std::vector<uint8_t> written_rows_;
   Cursor cursor_;
   std::vector<std::string> hyperlinks_ = {""};
+  std::unordered_map<std::string, uint16_t> hyperlink_ids_;
+
+  // The y coordinate of the first row. at(), PixelAt(), Row() and the stencil
+  // are offset by it. This is always 0, except for the screen a band is drawn
+  // into by RenderBands(). Every screen pays for it: a subtraction on each
+  // access, measured at up to 7% of BenchmarkPixelAt, and within noise when
+  // rendering elements.
+  int origin_y_ = 0;
 };
 
 }  // namespace ftxui
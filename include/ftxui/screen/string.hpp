@@ -4,10 +4,13 @@
 #ifndef FTXUI_SCREEN_STRING_HPP
 #define FTXUI_SCREEN_STRING_HPP
 
-#include <stddef.h>  // for size_t
-#include <cstdint>   // for uint8_t
-#include <string>    // for string, wstring, to_string
-#include <vector>    // for vector
+#include <stddef.h>     // for size_t
+#include <cstddef>      // for ptrdiff_t
+#include <cstdint>      // for uint8_t
+#include <iterator>     // for forward_iterator_tag
+#include <string>       // for string, wstring, to_string
+#include <string_view>  // for string_view
+#include <vector>       // for vector
 
 namespace ftxui {
 std::string to_string(const std::wstring& s);
@@ -24,6 +27,100 @@ int string_width(const std::string&);
 // ones.
 std::vector<std::string> Utf8ToGlyphs(const std::string& input);
 
+// A cell of an UTF8 string: a codepoint, followed by the combining characters
+// modifying it. |width| is the number of cells taken by the glyph starting in
+// this cell: 1, or 2 for fullwidth glyphs. The cell following a fullwidth glyph
+// has a width of 0. It only contains the combining characters following the
+// glyph, if any.
+struct GlyphView {
+  std::string_view text;
+  int width = 0;
+};
+
+// The cells of an UTF8 string, decoded one by one while iterating. This is
+// Utf8ToGlyphs() without copying the glyphs: the cells are the same. The string
+// must outlive the range.
+//
+// The text of a cell is a view into the string, except when combining
+// characters are separated from their glyph by control characters. This is
+// rare. The text is then copied into the iterator, and is valid until it is
+// incremented.
+//
+// ### Example
+//
+// ```cpp
+// for (const GlyphView& glyph : Utf8Glyphs(text)) {
+//   width += glyph.width;
+// }
+// ```
+class GlyphRange {
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = GlyphView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const GlyphView*;
+    using reference = const GlyphView&;
+
+    iterator() = default;
+    iterator(std::string_view input, size_t start);
+    iterator(const iterator& other) { *this = other; }
+    iterator& operator=(const iterator& other);
+    ~iterator() = default;
+
+    reference operator*() const { return glyph_; }
+    pointer operator->() const { return &glyph_; }
+    iterator& operator++() {
+      // Quick path: A printable ASCII character, followed by another one, so
+      // not by combining characters.
+      if (!fullwidth_ && next_ + 1 < input_.size() &&
+          IsPrintable(input_[next_]) && IsPrintable(input_[next_ + 1])) {
+        start_ = next_;
+        glyph_ = {input_.substr(next_, 1), 1};
+        ++next_;
+        return *this;
+      }
+      Next();
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+    // The cell following a fullwidth glyph starts where the next one does.
+    // They differ by their width.
+    bool operator==(const iterator& other) const {
+      return start_ == other.start_ && glyph_.width == other.glyph_.width;
+    }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+
+   private:
+    static bool IsPrintable(char c) { return c >= 0x20 && c < 0x7F; }  // NOLINT
+    void Next();
+    void Combine(size_t start);
+
+    std::string_view input_;
+    size_t start_ = std::string_view::npos;  // npos past the last cell.
+    size_t next_ = 0;         // Where to decode the next cell from.
+    bool fullwidth_ = false;  // Whether the next cell follows a fullwidth one.
+    GlyphView glyph_;
+    std::string composed_;  // See the GlyphRange comment.
+  };
+
+  explicit GlyphRange(std::string_view input) : input_(input) {}
+  iterator begin() const { return {input_, 0}; }
+  iterator end() const { return {input_, input_.size()}; }
+
+ private:
+  std::string_view input_;
+};
+
+inline GlyphRange Utf8Glyphs(std::string_view input) {
+  return GlyphRange(input);
+}
+
 // Map every cells drawn by |input| to their corresponding Glyphs. Half-size
 // Glyphs takes one cell, full-size Glyphs take two cells.
 std::vector<int> CellToGlyphIndex(const std::string& input);
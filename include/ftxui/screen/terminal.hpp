@@ -4,6 +4,8 @@
 #ifndef FTXUI_SCREEN_TERMINAL_HPP
 #define FTXUI_SCREEN_TERMINAL_HPP
 
+#include <functional>  // for function
+
 namespace ftxui {
 struct Dimensions {
   int dimx;
@@ -13,6 +15,9 @@ struct Dimensions {
 namespace Terminal {
 Dimensions Size();
 void SetFallbackSize(const Dimensions& fallbackSize);
+void SetSizeProvider(std::function<Dimensions()> provider);
+void SetSizeCaching(bool enable);
+void InvalidateSize();
 
 enum Color {
   Palette1,
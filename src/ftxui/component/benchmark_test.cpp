@@ -0,0 +1,57 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <benchmark/benchmark.h>
+#include <fcntl.h>   // for open, O_WRONLY
+#include <unistd.h>  // for dup, dup2, close, STDOUT_FILENO
+#include <csignal>   // for raise, SIGWINCH
+#include <iostream>  // for cout, flush
+#include <tuple>     // for ignore
+
+#include "ftxui/component/component.hpp"  // for Renderer
+#include "ftxui/component/event.hpp"      // for Event
+#include "ftxui/component/loop.hpp"       // for Loop
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/dom/elements.hpp"      // for text, border, center, operator|
+#include "ftxui/screen/terminal.hpp"   // for SetSizeProvider, Dimensions
+
+// NOLINTBEGIN
+namespace ftxui {
+
+// Resize the terminal before every frame, like when dragging the corner of the
+// window. The frames are sent to /dev/null.
+static void BenchmarkResizeStorm(benchmark::State& state) {
+  std::cout << std::flush;
+  const int saved_stdout = dup(STDOUT_FILENO);
+  const int dev_null = open("/dev/null", O_WRONLY);
+  dup2(dev_null, STDOUT_FILENO);
+
+  auto component = Renderer([] { return text("Resize") | border | center; });
+  auto screen = ScreenInteractive::Fullscreen();
+  if (state.range(0)) {
+    screen.ReserveSize(300, 100);
+  }
+  {
+    Loop loop(&screen, component);
+    int i = 0;
+    Terminal::SetSizeProvider([&] {
+      return Dimensions{100 + (i * 37) % 200, 30 + (i * 13) % 70};
+    });
+    for (auto _ : state) {
+      std::ignore = std::raise(SIGWINCH);
+      screen.PostEvent(Event::Custom);
+      loop.RunOnce();
+      ++i;
+    }
+  }
+  Terminal::SetSizeProvider(nullptr);
+
+  std::cout << std::flush;
+  dup2(saved_stdout, STDOUT_FILENO);
+  close(dev_null);
+  close(saved_stdout);
+}
+BENCHMARK(BenchmarkResizeStorm)->Arg(0)->Arg(1);  // Preallocated.
+
+}  // namespace ftxui
+// NOLINTEND
@@ -62,7 +62,7 @@ TEST(MenuTest, DirectionDown) {
   Screen screen(4, 3);
   Render(screen, menu->Render());
   EXPECT_EQ(screen.ToString(),
-            "\x1B[1m\x1B[7m> 1 \x1B[22m\x1B[27m\r\n"
+            "\x1B[1;7m> 1 \x1B[22;27m\r\n"
             "  2 \r\n"
             "  3 ");
 
@@ -89,7 +89,7 @@ TEST(MenuTest, DirectionsUp) {
   EXPECT_EQ(screen.ToString(),
             "  3 \r\n"
             "  2 \r\n"
-            "\x1B[1m\x1B[7m> 1 \x1B[22m\x1B[27m");
+            "\x1B[1;7m> 1 \x1B[22;27m");
   menu->OnEvent(Event::ArrowDown);
   EXPECT_EQ(selected, 0);
   menu->OnEvent(Event::ArrowUp);
@@ -111,7 +111,7 @@ TEST(MenuTest, DirectionsRight) {
   Screen screen(10, 1);
   Render(screen, menu->Render());
   EXPECT_EQ(screen.ToString(),
-            "\x1B[1m\x1B[7m> 1\x1B[22m\x1B[27m"
+            "\x1B[1;7m> 1\x1B[22;27m"
             "  2"
             "  3 ");
   menu->OnEvent(Event::ArrowLeft);
@@ -137,7 +137,7 @@ TEST(MenuTest, DirectionsLeft) {
   EXPECT_EQ(screen.ToString(),
             "  3"
             "  2"
-            "\x1B[1m\x1B[7m> 1\x1B[22m\x1B[27m ");
+            "\x1B[1;7m> 1\x1B[22;27m ");
   menu->OnEvent(Event::ArrowRight);
   EXPECT_EQ(selected, 0);
   menu->OnEvent(Event::ArrowLeft);
@@ -161,9 +161,9 @@ TEST(MenuTest, AnimationsHorizontal) {
     Render(screen, menu->Render());
     EXPECT_EQ(
         screen.ToString(),
-        "\x1B[1m\x1B[7m1\x1B[22m\x1B[27m \x1B[2m2\x1B[22m "
-        "\r\n\x1B[97m\x1B[49m\xE2\x94\x80\x1B[90m\x1B["
-        "49m\xE2\x95\xB6\xE2\x94\x80\xE2\x94\x80\x1B[39m\x1B[49m\r\n    ");
+        "\x1B[1;7m1\x1B[22;27m \x1B[2m2\x1B[22m "
+        "\r\n\x1B[97;49m\xE2\x94\x80\x1B[90;"
+        "49m\xE2\x95\xB6\xE2\x94\x80\xE2\x94\x80\x1B[39;49m\r\n    ");
   }
   selected = 1;
   {
@@ -172,8 +172,8 @@ TEST(MenuTest, AnimationsHorizontal) {
     EXPECT_EQ(
         screen.ToString(),
         "\x1B[7m1\x1B[27m \x1B[1m2\x1B[22m "
-        "\r\n\x1B[97m\x1B[49m\xE2\x94\x80\x1B[90m\x1B["
-        "49m\xE2\x95\xB6\xE2\x94\x80\xE2\x94\x80\x1B[39m\x1B[49m\r\n    ");
+        "\r\n\x1B[97;49m\xE2\x94\x80\x1B[90;"
+        "49m\xE2\x95\xB6\xE2\x94\x80\xE2\x94\x80\x1B[39;49m\r\n    ");
   }
   animation::Params params(2s);
   menu->OnAnimation(params);
@@ -183,8 +183,8 @@ TEST(MenuTest, AnimationsHorizontal) {
     EXPECT_EQ(
         screen.ToString(),
         "\x1B[7m1\x1B[27m \x1B[1m2\x1B[22m "
-        "\r\n\x1B[90m\x1B[49m\xE2\x94\x80\xE2\x95\xB4\x1B[97m\x1B["
-        "49m\xE2\x94\x80\x1B[90m\x1B[49m\xE2\x95\xB6\x1B[39m\x1B[49m\r\n    ");
+        "\r\n\x1B[90;49m\xE2\x94\x80\xE2\x95\xB4\x1B[97;"
+        "49m\xE2\x94\x80\x1B[90;49m\xE2\x95\xB6\x1B[39;49m\r\n    ");
   }
 }
 
@@ -197,10 +197,10 @@ TEST(MenuTest, AnimationsVertical) {
     Render(screen, menu->Render());
     EXPECT_EQ(
         screen.ToString(),
-        "\x1B[90m\x1B[49m\xE2\x94\x82\x1B[1m\x1B[7m\x1B[39m\x1B[49m1\x1B["
-        "22m\x1B[27m        "
-        "\r\n\x1B[97m\x1B[49m\xE2\x95\xB7\x1B[2m\x1B[39m\x1B[49m2\x1B[22m      "
-        "  \r\n\x1B[97m\x1B[49m\xE2\x94\x82\x1B[2m\x1B[39m\x1B[49m3\x1B[22m    "
+        "\x1B[90;49m\xE2\x94\x82\x1B[1;7;39;49m1\x1B["
+        "22;27m        "
+        "\r\n\x1B[97;49m\xE2\x95\xB7\x1B[2;39;49m2\x1B[22m      "
+        "  \r\n\x1B[97;49m\xE2\x94\x82\x1B[2;39;49m3\x1B[22m    "
         "    ");
   }
   selected = 1;
@@ -209,9 +209,9 @@ TEST(MenuTest, AnimationsVertical) {
     Render(screen, menu->Render());
     EXPECT_EQ(
         screen.ToString(),
-        "\x1B[90m\x1B[49m\xE2\x94\x82\x1B[7m\x1B[39m\x1B[49m1\x1B[27m        "
-        "\r\n\x1B[97m\x1B[49m\xE2\x95\xB7\x1B[1m\x1B[39m\x1B[49m2\x1B[22m      "
-        "  \r\n\x1B[97m\x1B[49m\xE2\x94\x82\x1B[2m\x1B[39m\x1B[49m3\x1B[22m    "
+        "\x1B[90;49m\xE2\x94\x82\x1B[7;39;49m1\x1B[27m        "
+        "\r\n\x1B[97;49m\xE2\x95\xB7\x1B[1;39;49m2\x1B[22m      "
+        "  \r\n\x1B[97;49m\xE2\x94\x82\x1B[2;39;49m3\x1B[22m    "
         "    ");
   }
   animation::Params params(2s);
@@ -221,9 +221,9 @@ TEST(MenuTest, AnimationsVertical) {
     Render(screen, menu->Render());
     EXPECT_EQ(
         screen.ToString(),
-        "\x1B[97m\x1B[49m\xE2\x95\xB5\x1B[7m\x1B[39m\x1B[49m1\x1B[27m        "
-        "\r\n\x1B[90m\x1B[49m\xE2\x94\x82\x1B[1m\x1B[39m\x1B[49m2\x1B[22m      "
-        "  \r\n\x1B[97m\x1B[49m\xE2\x95\xB7\x1B[2m\x1B[39m\x1B[49m3\x1B[22m    "
+        "\x1B[97;49m\xE2\x95\xB5\x1B[7;39;49m1\x1B[27m        "
+        "\r\n\x1B[90;49m\xE2\x94\x82\x1B[1;39;49m2\x1B[22m      "
+        "  \r\n\x1B[97;49m\xE2\x95\xB7\x1B[2;39;49m3\x1B[22m    "
         "    ");
   }
 }
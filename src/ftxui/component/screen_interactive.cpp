@@ -4,6 +4,7 @@
 #include <algorithm>  // for copy, max, min
 #include <array>      // for array
 #include <chrono>  // for operator-, milliseconds, operator>=, duration, common_type<>::type, time_point
+#include <cerrno>   // for errno, EAGAIN, EINTR, EWOULDBLOCK
 #include <csignal>  // for signal, SIGTSTP, SIGABRT, SIGWINCH, raise, SIGFPE, SIGILL, SIGINT, SIGSEGV, SIGTERM, __sighandler_t, size_t
 #include <cstdio>   // for fileno, stdin
 #include <ftxui/component/task.hpp>  // for Task, Closure, AnimationTask
@@ -11,6 +12,7 @@
 #include <functional>        // for function
 #include <initializer_list>  // for initializer_list
 #include <iostream>  // for cout, ostream, operator<<, basic_ostream, endl, flush
+#include <memory>    // for make_unique, unique_ptr
 #include <stack>     // for stack
 #include <thread>    // for thread, sleep_for
 #include <tuple>     // for _Swallow_assign, ignore
@@ -27,6 +29,7 @@
 #include "ftxui/component/receiver.hpp"  // for ReceiverImpl, Sender, MakeReceiver, SenderImpl, Receiver
 #include "ftxui/component/screen_interactive.hpp"
 #include "ftxui/component/terminal_input_parser.hpp"  // for TerminalInputParser
+#include "ftxui/dom/element_arena.hpp"                // for ElementArena
 #include "ftxui/dom/node.hpp"                         // for Node, Render
 #include "ftxui/dom/requirement.hpp"                  // for Requirement
 #include "ftxui/screen/terminal.hpp"                  // for Dimensions, Size
@@ -44,7 +47,7 @@
 #else
 #include <sys/select.h>  // for select, FD_ISSET, FD_SET, FD_ZERO, fd_set, timeval
 #include <termios.h>  // for tcsetattr, termios, tcgetattr, TCSANOW, cc_t, ECHO, ICANON, VMIN, VTIME
-#include <unistd.h>  // for STDIN_FILENO, read
+#include <unistd.h>  // for STDIN_FILENO, STDOUT_FILENO, read, write
 #endif
 
 // Quick exit is missing in standard CLang headers
@@ -72,6 +75,44 @@ void Flush() {
   std::cout << '\0' << std::flush;
 }
 
+// Send |data| to the terminal, bypassing the std::cout buffer when possible.
+// Return the number of write calls used.
+int Write(const std::string& data) {
+#if defined(_WIN32) || defined(__EMSCRIPTEN__)
+  std::cout << data;
+  Flush();
+  return 1;
+#else
+  // What was previously printed using std::cout must reach the terminal first.
+  std::cout << std::flush;
+
+  int calls = 0;
+  size_t written = 0;
+  while (written < data.size()) {
+    ++calls;
+    const ssize_t n =
+        write(STDOUT_FILENO, data.data() + written, data.size() - written);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // The output is non blocking and full. Wait for the terminal to read
+        // it, instead of spinning.
+        fd_set fds;
+        FD_ZERO(&fds);                                               // NOLINT
+        FD_SET(STDOUT_FILENO, &fds);                                 // NOLINT
+        select(STDOUT_FILENO + 1, nullptr, &fds, nullptr, nullptr);  // NOLINT
+        continue;
+      }
+      break;
+    }
+    written += size_t(n);
+  }
+  return calls;
+#endif
+}
+
 constexpr int timeout_milliseconds = 20;
 [[maybe_unused]] constexpr int timeout_microseconds =
     timeout_milliseconds * 1000;
@@ -340,6 +381,10 @@ ScreenInteractive::ScreenInteractive(int dimx,
       dimension_(dimension),
       use_alternative_screen_(use_alternative_screen) {
   task_receiver_ = MakeReceiver<Task>();
+
+  // On the alternative screen, the frame is displayed at the top of the
+  // terminal. The differential output can scroll regions of it.
+  output_options_.scroll_region = use_alternative_screen;
 }
 
 // static
@@ -402,6 +447,102 @@ void ScreenInteractive::TrackMouse(bool enable) {
   track_mouse_ = enable;
 }
 
+/// @ingroup component
+/// @brief Set whether only the cells modified since the previous frame are sent
+/// to the terminal.
+/// @param enable Whether to enable the differential output.
+/// @note The whole screen is still printed after a resize, or when the terminal
+/// state might have been modified by someone else.
+/// @note The number of bytes sent to the terminal can be observed using
+/// `ScreenInteractive::stats()`.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.DifferentialOutput();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::DifferentialOutput(bool enable) {
+  differential_output_ = enable;
+  previous_frame_.Resize(0, 0);
+}
+
+/// @ingroup component
+/// @brief Set whether the frames are wrapped into the "synchronized update"
+/// mode (DEC private mode 2026). Supporting terminals present each frame
+/// atomically, instead of displaying partially drawn frames. Others ignore it.
+/// @param enable Whether to enable the synchronized update mode.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::FitComponent();
+/// screen.SynchronizedUpdate();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::SynchronizedUpdate(bool enable) {
+  synchronized_update_ = enable;
+}
+
+/// @ingroup component
+/// @brief Set whether the output is compressed, using the REP (repeat the
+/// previous character) and EL (erase to the end of the line) sequences. Runs of
+/// identical cells and trailing blank cells are not sent cell by cell.
+/// @param enable Whether to enable the output compression.
+/// @note This requires the terminal to support the REP sequence. This is the
+/// case of most modern terminal emulators, but not of the Linux console.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.CompressOutput();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::CompressOutput(bool enable) {
+  output_options_.repeat = enable;
+  output_options_.erase_line = enable;
+}
+
+/// @ingroup component
+/// @brief Preallocate the frame buffers for a terminal of up to |dimx| x |dimy|
+/// cells. Resizing the terminal within these bounds doesn't allocate.
+/// @param dimx The maximum width of the terminal.
+/// @param dimy The maximum height of the terminal.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.ReserveSize(400, 200);
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::ReserveSize(int dimx, int dimy) {
+  Reserve(dimx, dimy);
+  previous_frame_.Reserve(dimx, dimy);
+}
+
+/// @ingroup component
+/// @brief Allocate the elements of each frame in an ElementArena, instead of
+/// allocating each of them on the heap. The memory is reused from one frame to
+/// the next.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.UseElementArena();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::UseElementArena(bool enable) {
+  if (!enable) {
+    element_arena_.reset();
+  } else if (!element_arena_) {
+    element_arena_ = std::make_unique<ElementArena>();
+  }
+}
+
 /// @brief Add a task to the main loop. 
 /// It will be executed later, after every other scheduled tasks.
 /// @ingroup component
@@ -534,6 +675,9 @@ ScreenInteractive* ScreenInteractive::Active() {
 void ScreenInteractive::Install() {
   frame_valid_ = false;
 
+  // The terminal content is unknown. The next frame must be printed entirely.
+  previous_frame_.Resize(0, 0);
+
   // After uninstalling the new configuration, flush it to the terminal to
   // ensure it is fully applied:
   on_exit_functions.push([] { Flush(); });
@@ -582,6 +726,10 @@ void ScreenInteractive::Install() {
     InstallSignalHandler(signal);
   }
 
+  // The terminal size only changes on SIGWINCH. Avoid querying it every frame.
+  Terminal::SetSizeCaching(true);
+  on_exit_functions.push([] { Terminal::SetSizeCaching(false); });
+
   struct termios terminal;  // NOLINT
   tcgetattr(STDIN_FILENO, &terminal);
   on_exit_functions.push([=] { tcsetattr(STDIN_FILENO, TCSANOW, &terminal); });
@@ -730,6 +878,12 @@ void ScreenInteractive::Draw(Component component) {
   if (frame_valid_) {
     return;
   }
+
+  // The elements of the previous frame are destroyed, their memory is reused.
+  if (element_arena_) {
+    element_arena_->Reset();
+  }
+  const ElementArena::Scope element_arena_scope(element_arena_.get());
   auto document = component->Render();
   int dimx = 0;
   int dimy = 0;
@@ -754,17 +908,21 @@ void ScreenInteractive::Draw(Component component) {
       break;
   }
 
+  // The whole frame is assembled into a single buffer, and sent to the terminal
+  // at once.
+  output_buffer_.clear();
+  if (synchronized_update_) {
+    output_buffer_ += "\x1B[?2026h";  // BEGIN_SYNCHRONIZED_UPDATE
+  }
+
   const bool resized = (dimx != dimx_) || (dimy != dimy_);
-  ResetCursorPosition();
-  std::cout << ResetPosition(/*clear=*/resized);
+  output_buffer_ += reset_cursor_position;
+  reset_cursor_position = "";
+  output_buffer_ += ResetPosition(/*clear=*/resized);
 
   // Resize the screen if needed.
   if (resized) {
-    dimx_ = dimx;
-    dimy_ = dimy;
-    pixels_ = std::vector<std::vector<Pixel>>(dimy, std::vector<Pixel>(dimx));
-    cursor_.x = dimx_ - 1;
-    cursor_.y = dimy_ - 1;
+    Resize(dimx, dimy);
   }
 
   // Periodically request the terminal emulator the frame position relative to
@@ -780,14 +938,14 @@ void ScreenInteractive::Draw(Component component) {
   static int i = -3;
   ++i;
   if (!use_alternative_screen_ && (i % 150 == 0)) {  // NOLINT
-    std::cout << DeviceStatusReport(DSRMode::kCursor);
+    output_buffer_ += DeviceStatusReport(DSRMode::kCursor);
   }
 #else
   static int i = -3;
   ++i;
   if (!use_alternative_screen_ &&
       (previous_frame_resized_ || i % 40 == 0)) {  // NOLINT
-    std::cout << DeviceStatusReport(DSRMode::kCursor);
+    output_buffer_ += DeviceStatusReport(DSRMode::kCursor);
   }
 #endif
   previous_frame_resized_ = resized;
@@ -796,13 +954,27 @@ void ScreenInteractive::Draw(Component component) {
 
   // Set cursor position for user using tools to insert CJK characters.
   {
-    const int dx = dimx_ - 1 - cursor_.x + int(dimx_ != terminal.dimx);
     const int dy = dimy_ - 1 - cursor_.y;
 
-    set_cursor_position = "\x1B[" + std::to_string(dy) + "A" +  //
-                          "\x1B[" + std::to_string(dx) + "D";
-    reset_cursor_position = "\x1B[" + std::to_string(dy) + "B" +  //
-                            "\x1B[" + std::to_string(dx) + "C";
+    if (differential_output_) {
+      // The differential output leaves the cursor at the beginning of the last
+      // line.
+      set_cursor_position = "";
+      reset_cursor_position = "";
+      if (dy != 0) {
+        set_cursor_position += "\x1B[" + std::to_string(dy) + "A";
+        reset_cursor_position += "\x1B[" + std::to_string(dy) + "B";
+      }
+      if (cursor_.x > 0) {
+        set_cursor_position += "\x1B[" + std::to_string(cursor_.x) + "C";
+      }
+    } else {
+      const int dx = dimx_ - 1 - cursor_.x + int(dimx_ != terminal.dimx);
+      set_cursor_position = "\x1B[" + std::to_string(dy) + "A" +  //
+                            "\x1B[" + std::to_string(dx) + "D";
+      reset_cursor_position = "\x1B[" + std::to_string(dy) + "B" +  //
+                              "\x1B[" + std::to_string(dx) + "C";
+    }
 
     if (cursor_.shape == Cursor::Hidden) {
       set_cursor_position += "\033[?25l";
@@ -813,8 +985,33 @@ void ScreenInteractive::Draw(Component component) {
     }
   }
 
-  std::cout << ToString() << set_cursor_position;
-  Flush();
+  if (differential_output_) {
+    ToStringDiff(previous_frame_, output_buffer_, output_options_);
+  } else {
+    ToString(output_buffer_, output_options_);
+  }
+  output_buffer_ += set_cursor_position;
+  if (synchronized_update_) {
+    output_buffer_ += "\x1B[?2026l";  // END_SYNCHRONIZED_UPDATE
+  }
+  const int writes = Write(output_buffer_);
+
+  stats_.frame_count++;
+  stats_.bytes_last_frame = output_buffer_.size();
+  stats_.bytes_total += output_buffer_.size();
+  stats_.writes_last_frame = writes;
+  stats_.writes_total += writes;
+
+  // The current frame becomes the previous one. Its storage is swapped with
+  // the previous frame's one, instead of copying the pixels and hyperlinks, and
+  // is cleared for the next frame.
+  if (differential_output_) {
+    if (previous_frame_.dimx() == dimx_ && previous_frame_.dimy() == dimy_) {
+      std::swap(static_cast<Screen&>(*this), previous_frame_);
+    } else {
+      previous_frame_ = *this;
+    }
+  }
   Clear();
   frame_valid_ = true;
 }
@@ -867,6 +1064,7 @@ void ScreenInteractive::Signal(int signal) {
   }
 
   if (signal == SIGWINCH) {
+    Terminal::InvalidateSize();
     Post(Event::Special({0}));
     return;
   }
@@ -2,17 +2,74 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <gtest/gtest.h>  // for Test, TestInfo (ptr only), TEST, EXPECT_EQ, Message, TestPartResult
+#include <chrono>   // for milliseconds
 #include <csignal>  // for raise, SIGABRT, SIGFPE, SIGILL, SIGINT, SIGSEGV, SIGTERM
 #include <ftxui/component/event.hpp>  // for Event, Event::Custom
+#include <iostream>                   // for cout, flush
+#include <string>                     // for to_string, string
+#include <thread>                     // for thread, sleep_for
 #include <tuple>                      // for _Swallow_assign, ignore
 
 #include "ftxui/component/component.hpp"  // for Renderer
+#include "ftxui/component/loop.hpp"       // for Loop
 #include "ftxui/component/screen_interactive.hpp"
 #include "ftxui/dom/elements.hpp"  // for text, Element
 
+#if !defined(_WIN32)
+#include <fcntl.h>   // for fcntl, F_GETFL, F_SETFL, O_NONBLOCK
+#include <unistd.h>  // for close, dup, dup2, pipe, read, STDOUT_FILENO
+#endif
+
 namespace ftxui {
 
 namespace {
+
+#if !defined(_WIN32)
+// Redirect the standard output into a pipe, until Stop() returns what was
+// written. The pipe is read by a thread, starting after |read_delay|.
+class StdoutCapture {
+ public:
+  explicit StdoutCapture(bool non_blocking = false,
+                         std::chrono::milliseconds read_delay = {}) {
+    std::cout << std::flush;
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+    if (non_blocking) {
+      fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);  // NOLINT
+    }
+    saved_stdout_ = dup(STDOUT_FILENO);
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[1]);
+    read_end_ = fds[0];
+    reader_ = std::thread([this, read_delay] {
+      std::this_thread::sleep_for(read_delay);
+      char buffer[4096];
+      ssize_t n = 0;
+      while ((n = read(read_end_, buffer, sizeof(buffer))) > 0) {
+        output_.append(buffer, size_t(n));
+      }
+    });
+  }
+
+  std::string Stop() {
+    std::cout << std::flush;
+    std::cout.clear();
+    // Closing the last write end of the pipe ends the reader.
+    dup2(saved_stdout_, STDOUT_FILENO);
+    close(saved_stdout_);
+    reader_.join();
+    close(read_end_);
+    return output_;
+  }
+
+ private:
+  int saved_stdout_ = -1;
+  int read_end_ = -1;
+  std::thread reader_;
+  std::string output_;
+};
+#endif
+
 bool TestSignal(int signal) {
   int called = 0;
   // The tree of components. This defines how to navigate using the keyboard.
@@ -64,4 +121,136 @@ TEST(ScreenInteractive, PostTaskToNonActive) {
   screen.Post([] {});
 }
 
+TEST(ScreenInteractive, DifferentialOutput) {
+  int counter = 0;
+  auto component = Renderer([&] {
+    return vbox({
+        text("A static line of text"),
+        text("Another static line of text"),
+        text(std::to_string(counter)),
+    });
+  });
+
+  auto screen = ScreenInteractive::FixedSize(30, 3);
+  screen.DifferentialOutput();
+  {
+    Loop loop(&screen, component);
+    loop.RunOnce();
+    const size_t full_frame = screen.stats().bytes_last_frame;
+
+    counter = 1;
+    screen.PostEvent(Event::Custom);
+    loop.RunOnce();
+    const size_t diff_frame = screen.stats().bytes_last_frame;
+
+    EXPECT_EQ(screen.stats().frame_count, 2);
+    EXPECT_EQ(screen.stats().bytes_total, full_frame + diff_frame);
+    EXPECT_LT(diff_frame, full_frame / 2);
+  }
+}
+
+TEST(ScreenInteractive, DifferentialOutputReusesFrames) {
+  bool tall = true;
+  auto component = Renderer([&] {
+    if (!tall) {
+      return text("A line of text");
+    }
+    return vbox({
+        text("A line of text"),
+        text("Another line of text"),
+        text("A third line of text"),
+    });
+  });
+
+  auto screen = ScreenInteractive::FixedSize(30, 3);
+  screen.DifferentialOutput();
+  {
+    Loop loop(&screen, component);
+    loop.RunOnce();
+
+    // The frames are drawn into the storage of the frame before the previous
+    // one. It must not leak into them.
+    tall = false;
+    screen.PostEvent(Event::Custom);
+    loop.RunOnce();
+    const size_t shrunk_frame = screen.stats().bytes_last_frame;
+
+    // Nothing changes anymore, only the cursor is moved.
+    for (int i = 0; i < 2; ++i) {
+      screen.PostEvent(Event::Custom);
+      loop.RunOnce();
+      EXPECT_LT(screen.stats().bytes_last_frame, shrunk_frame / 2);
+    }
+    EXPECT_EQ(screen.stats().frame_count, 4);
+  }
+}
+
+TEST(ScreenInteractive, SynchronizedUpdate) {
+  auto component = Renderer([] { return text("Hello"); });
+
+  auto screen = ScreenInteractive::FixedSize(5, 1);
+  screen.SynchronizedUpdate();
+#if !defined(_WIN32)
+  StdoutCapture capture;
+#endif
+  {
+    Loop loop(&screen, component);
+    loop.RunOnce();
+    screen.PostEvent(Event::Custom);
+    loop.RunOnce();
+  }
+  // Every frame is sent to the terminal using a single write.
+  EXPECT_EQ(screen.stats().frame_count, 2);
+  EXPECT_EQ(screen.stats().writes_last_frame, 1);
+  EXPECT_EQ(screen.stats().writes_total, 2u);
+
+#if !defined(_WIN32)
+  // Every frame is wrapped into the synchronized update sequences.
+  const std::string output = capture.Stop();
+  const std::string begin = "\x1B[?2026h";
+  const std::string end = "\x1B[?2026l";
+  size_t position = 0;
+  for (int frame = 0; frame < 2; ++frame) {
+    const size_t frame_begin = output.find(begin, position);
+    ASSERT_NE(frame_begin, std::string::npos);
+    const size_t frame_end = output.find(end, frame_begin);
+    ASSERT_NE(frame_end, std::string::npos);
+    const std::string content =
+        output.substr(frame_begin, frame_end - frame_begin);
+    EXPECT_EQ(content.find(begin, begin.size()), std::string::npos);
+    EXPECT_NE(content.find("Hello"), std::string::npos);
+    position = frame_end + end.size();
+  }
+  EXPECT_EQ(output.find(begin, position), std::string::npos);
+  EXPECT_EQ(output.find("Hello", position), std::string::npos);
+#endif
+}
+
+#if !defined(_WIN32)
+TEST(ScreenInteractive, NonBlockingOutput) {
+  auto component = Renderer([] {
+    Elements lines;
+    for (int i = 0; i < 200; ++i) {
+      lines.push_back(text(std::string(400, 'a' + i % 26)));
+    }
+    return vbox(std::move(lines));
+  });
+
+  // The frame is larger than the pipe, which is read only after a while.
+  auto screen = ScreenInteractive::FixedSize(400, 200);
+  StdoutCapture capture(/*non_blocking=*/true, std::chrono::milliseconds(100));
+  {
+    Loop loop(&screen, component);
+    loop.RunOnce();
+  }
+  const std::string output = capture.Stop();
+
+  // The output waits for the pipe to be read, instead of retrying the write.
+  // The write calls are bounded by the number of reads of the pipe.
+  EXPECT_EQ(screen.stats().frame_count, 1);
+  EXPECT_LT(screen.stats().writes_last_frame, 100);
+  EXPECT_NE(output.find(std::string(400, 'z')), std::string::npos);
+}
+#endif
+
 }  // namespace ftxui
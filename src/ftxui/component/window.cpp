@@ -6,6 +6,7 @@
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/component_base.hpp>
 #include <ftxui/component/screen_interactive.hpp>  // for ScreenInteractive
+#include "ftxui/dom/element_arena.hpp"             // for MakeElement
 #include "ftxui/dom/node_decorator.hpp"            // for NodeDecorator
 
 namespace ftxui {
@@ -96,7 +97,7 @@ Element DefaultRenderState(const WindowRenderState& state) {
 
   const Color color = Color::Red;
 
-  element = std::make_shared<ResizeDecorator>(  //
+  element = MakeElement<ResizeDecorator>(  //
       element,                                  //
       state.hover_left,                         //
       state.hover_right,                        //
@@ -2,13 +2,43 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <benchmark/benchmark.h>
+#include <algorithm>  // for max, min
+#include <atomic>     // for atomic
+#include <cstdint>    // for int64_t
+#include <cstdlib>    // for malloc, free
 #include <iostream>
+#include <new>      // for bad_alloc
+#include <string>   // for string, to_string
+#include <thread>   // for thread
+#include <utility>  // for move
+#include <vector>   // for vector
 
+#include "ftxui/dom/element_arena.hpp"  // for ElementArena
 #include "ftxui/dom/elements.hpp"  // for gauge, separator, operator|, text, Element, hbox, vbox, blink, border, inverted
-#include "ftxui/dom/node.hpp"      // for Render
+#include "ftxui/dom/node.hpp"      // for Render, RenderBands
 #include "ftxui/screen/screen.hpp"  // for Screen
 
 // NOLINTBEGIN
+
+// Count the heap allocations, reported by the benchmarks using them.
+static std::atomic<int64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t /*size*/) noexcept {
+  std::free(memory);
+}
+
 namespace ftxui {
 
 static void BencharkBasic(benchmark::State& state) {
@@ -49,6 +79,182 @@ static void BencharkText(benchmark::State& state) {
 }
 BENCHMARK(BencharkText)->DenseRange(0, 10, 1);
 
+// A paragraph of 10k words. Argument: whether the element is retained across
+// the frames, or built again for every frame.
+static void BenchmarkParagraph(benchmark::State& state) {
+  std::string content;
+  for (int i = 0; i < 10000; ++i) {
+    content += "word" + std::to_string(i % 100) + " ";
+  }
+  Element document = paragraph(content);
+  Screen screen(80, 50);
+  for (auto _ : state) {
+    if (!state.range(0)) {
+      document = paragraph(content);
+    }
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkParagraph)->Arg(0)->Arg(1);
+
+// Thousands of text nodes. Argument: whether the document is retained across
+// the frames, or built again for every frame.
+static void BenchmarkTextNodes(benchmark::State& state) {
+  auto build = [] {
+    Elements lines;
+    for (int i = 0; i < 200; ++i) {
+      Elements words;
+      for (int j = 0; j < 10; ++j) {
+        words.push_back(text(j % 3 ? "word" + std::to_string(i) : "字符"));
+      }
+      lines.push_back(hbox(std::move(words)));
+    }
+    return vbox(std::move(lines));
+  };
+  Element document = build();
+  Screen screen(120, 200);
+  for (auto _ : state) {
+    if (!state.range(0)) {
+      document = build();
+    }
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkTextNodes)->Arg(0)->Arg(1);
+
+// A virtual list, scrolled to its middle. Argument: the number of rows.
+static void BenchmarkVirtualList(benchmark::State& state) {
+  const int count = int(state.range(0));
+  const int focused = count / 2;
+  Screen screen(80, 50);
+  for (auto _ : state) {
+    auto list = virtualList(
+        count, 1,
+        [&](int i) {
+          auto row = text("Row " + std::to_string(i));
+          return i == focused ? row | inverted | focus : row;
+        },
+        focused);
+    Render(screen, list | vscroll_indicator | frame | border);
+  }
+}
+BENCHMARK(BenchmarkVirtualList)->RangeMultiplier(100)->Range(100, 10000000);
+
+// A long list of rows inside a frame, scrolled to its middle. Only a few rows
+// are visible. Argument: the number of rows.
+static void BenchmarkFrame(benchmark::State& state) {
+  const int count = int(state.range(0));
+  Elements rows;
+  for (int i = 0; i < count; ++i) {
+    auto row = hbox({text("Row "), text(std::to_string(i)) | bold});
+    rows.push_back(i == count / 2 ? row | focus : row);
+  }
+  Element document = vbox(std::move(rows)) | vscroll_indicator | frame | border;
+  Screen screen(80, 50);
+  for (auto _ : state) {
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkFrame)->RangeMultiplier(10)->Range(100, 100000);
+
+// A long document printed a band of 50 lines at a time. Argument: the number
+// of rows.
+static void BenchmarkRenderBands(benchmark::State& state) {
+  const int count = int(state.range(0));
+  Elements rows;
+  for (int i = 0; i < count; ++i) {
+    rows.push_back(hbox({text("Row "), text(std::to_string(i)) | bold}));
+  }
+  Element document = vbox(std::move(rows)) | border;
+  for (auto _ : state) {
+    Screen screen(80, 50);
+    RenderBands(screen, document, [](Screen& band) {
+      benchmark::DoNotOptimize(band.PixelAt(0, 0));
+    });
+  }
+}
+BENCHMARK(BenchmarkRenderBands)->RangeMultiplier(10)->Range(100, 100000);
+
+// A large static panel next to a line changing every frame. Argument: whether
+// the panel is memoized.
+static void BenchmarkMemo(benchmark::State& state) {
+  auto panel = [] {
+    Elements rows;
+    for (int i = 0; i < 2000; ++i) {
+      rows.push_back(hbox({text("Row "), text(std::to_string(i)) | bold}));
+    }
+    return vbox(std::move(rows)) | border;
+  };
+  MemoKey key;
+  Screen screen(80, 50);
+  int frame = 0;
+  for (auto _ : state) {
+    Element static_part = state.range(0) ? memo(key, 0, panel) : panel();
+    Render(screen, vbox({
+                       text("Frame " + std::to_string(frame++)),
+                       static_part,
+                   }));
+  }
+}
+BENCHMARK(BenchmarkMemo)->Arg(0)->Arg(1);
+
+// A static plot and help panel, next to a line changing every frame.
+// Argument: whether the panel is drawn in a layer.
+static void BenchmarkLayer(benchmark::State& state) {
+  auto plot = Canvas(156, 100);
+  for (int i = 0; i < 100; i += 2) {
+    plot.DrawPointLine(0, i, 155, 99 - i);
+  }
+  std::string help;
+  for (int i = 0; i < 200; ++i) {
+    help += "help" + std::to_string(i) + " ";
+  }
+  Element panel = vbox({
+                      canvas(std::move(plot)) | border,
+                      paragraph(help) | border,
+                  }) |
+                  color(Color::Blue);
+  LayerKey key;
+  Screen screen(80, 50);
+  int frame = 0;
+  for (auto _ : state) {
+    Render(screen, vbox({
+                       text("Frame " + std::to_string(frame++)),
+                       state.range(0) ? panel | layer(key, 0) : panel,
+                   }));
+  }
+}
+BENCHMARK(BenchmarkLayer)->Arg(0)->Arg(1);
+
+// A document of 18k elements, built every frame. Argument: whether the
+// elements are allocated in an ElementArena.
+static void BenchmarkElementArena(benchmark::State& state) {
+  auto build = [] {
+    Elements rows;
+    for (int i = 0; i < 2000; ++i) {
+      rows.push_back(hbox({
+          text("Row ") | color(Color::Blue),
+          text(std::to_string(i)) | bold,
+          separator(),
+          text("ok") | dim | flex,
+      }));
+    }
+    return vbox(std::move(rows)) | vscroll_indicator | frame | border;
+  };
+  ElementArena arena;
+  Screen screen(80, 50);
+  const int64_t allocations = g_allocations;
+  for (auto _ : state) {
+    arena.Reset();
+    const ElementArena::Scope scope(state.range(0) ? &arena : nullptr);
+    Render(screen, build());
+  }
+  state.counters["allocations"] =
+      benchmark::Counter(double(g_allocations - allocations),
+                         benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BenchmarkElementArena)->Arg(0)->Arg(1);
+
 static void BenchmarkStyle(benchmark::State& state) {
   while (state.KeepRunning()) {
     Elements elements;
@@ -83,5 +289,207 @@ BENCHMARK(BenchmarkStyle)
         benchmark::CreateDenseRange(10, 200, 20),  // Screen width.
     });
 
+// A fullscreen dashboard of bordered panels, with styled text and gauges,
+// drawn and printed every frame. Argument: the size of the screen.
+static void BenchmarkRenderToString(benchmark::State& state) {
+  const int size = state.range(0);
+  Elements rows;
+  for (int y = 0; y < size / 6; ++y) {
+    Elements panels;
+    for (int x = 0; x < size / 25; ++x) {
+      const float progress = float((x + y) % 10) / 10.f;
+      panels.push_back(vbox({
+                           text("Panel " + std::to_string(x)) | bold,
+                           text("status: ok") | color(Color::Green),
+                           gauge(progress) | color(Color::RGB(42, 87, 124)),
+                           text("load") | bgcolor(Color::Blue) | dim,
+                       }) |
+                       border | flex);
+    }
+    rows.push_back(hbox(std::move(panels)));
+  }
+  auto document = vbox(std::move(rows));
+  Screen screen(size, size);
+  while (state.KeepRunning()) {
+    screen.Clear();
+    Render(screen, document);
+    benchmark::DoNotOptimize(screen.ToString());
+  }
+}
+BENCHMARK(BenchmarkRenderToString)->Arg(200)->Arg(400);
+
+// Clear a screen whose rows have all been modified, or none of them.
+static void BenchmarkScreenClear(benchmark::State& state) {
+  Screen screen(state.range(0), state.range(1));
+  const bool dirty = state.range(2);
+  while (state.KeepRunning()) {
+    if (dirty) {
+      for (int y = 0; y < screen.dimy(); ++y) {
+        screen.Row(y)[0].character = "a";
+      }
+    }
+    screen.Clear();
+    benchmark::DoNotOptimize(screen.PixelAt(0, 0));
+  }
+  state.counters["bytes_per_cell"] = sizeof(Pixel);
+}
+BENCHMARK(BenchmarkScreenClear)
+    ->Args({80, 24, 1})
+    ->Args({200, 60, 1})
+    ->Args({500, 200, 1})
+    ->Args({80, 24, 0})
+    ->Args({200, 60, 0})
+    ->Args({500, 200, 0});
+
+static void BenchmarkScreenToString(benchmark::State& state) {
+  Screen screen(state.range(0), state.range(0));
+  for (int y = 0; y < screen.dimy(); ++y) {
+    for (int x = 0; x < screen.dimx(); ++x) {
+      screen.at(x, y) = (x + y) % 3 ? "a" : "─";
+    }
+  }
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(screen.ToString());
+  }
+  state.counters["bytes_per_cell"] = sizeof(Pixel);
+}
+BENCHMARK(BenchmarkScreenToString)->RangeMultiplier(2)->Range(50, 400);
+
+// A static fullscreen UI, where only a counter changes, printed as the
+// difference with the previous frame. Argument: the size of the screen.
+static void BenchmarkScreenDiff(benchmark::State& state) {
+  const int size = int(state.range(0));
+  const auto document = [&](int counter) {
+    Elements rows;
+    rows.push_back(text("Counter: " + std::to_string(counter)));
+    for (int i = 1; i < size; ++i) {
+      rows.push_back(hbox({
+          text("Row " + std::to_string(i)) | bold,
+          filler(),
+          text("Static") | color(Color::Blue),
+      }));
+    }
+    return vbox(std::move(rows)) | border;
+  };
+  Screen previous(size, size);
+  Screen screen(size, size);
+  Render(previous, document(0));
+  Render(screen, document(1));
+  std::string out;
+  while (state.KeepRunning()) {
+    out.clear();
+    screen.ToStringDiff(previous, out);
+  }
+  state.counters["bytes"] = out.size();
+}
+BENCHMARK(BenchmarkScreenDiff)->Arg(80)->Arg(200)->Arg(400);
+
+// Write every cell of a screen.
+static void BenchmarkPixelAt(benchmark::State& state) {
+  Screen screen(state.range(0), state.range(0));
+  while (state.KeepRunning()) {
+    for (int y = 0; y < screen.dimy(); ++y) {
+      for (int x = 0; x < screen.dimx(); ++x) {
+        screen.PixelAt(x, y).bold = true;
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BenchmarkPixelAt)->Arg(80)->Arg(200)->Arg(400);
+
+// Encode a tall screen using several threads.
+static void BenchmarkToStringThreads(benchmark::State& state) {
+  Screen screen(400, 5000);
+  for (int y = 0; y < screen.dimy(); ++y) {
+    Pixel* row = screen.Row(y);
+    for (int x = 0; x < screen.dimx(); ++x) {
+      row[x].character = x % 10 ? "a" : "│";
+      row[x].foreground_color = Color::Palette256(x % 256);
+      row[x].bold = y % 2;
+    }
+  }
+  Screen::OutputOptions options;
+  options.threads = state.range(0);
+  std::string out;
+  while (state.KeepRunning()) {
+    out.clear();
+    screen.ToString(out, options);
+  }
+  // ToString() encodes at most one band of lines per core.
+  const int cores = int(std::max(std::thread::hardware_concurrency(), 1U));
+  state.counters["bands"] = std::min({options.threads, screen.dimy(), cores});
+}
+// Request up to 16 threads, but no more than the cores: the extra ones would
+// measure the same configuration again.
+static void ToStringThreadsArguments(benchmark::internal::Benchmark* b) {
+  const int cores = int(std::max(std::thread::hardware_concurrency(), 1U));
+  for (int threads = 1; threads <= std::min(16, cores); threads *= 2) {
+    b->Arg(threads);
+  }
+}
+BENCHMARK(BenchmarkToStringThreads)
+    ->Apply(ToStringThreadsArguments)
+    ->UseRealTime();
+
+// Merge the box drawing characters of a grid of bordered cells, filling a
+// square screen. Argument: the size of the screen.
+static void BenchmarkApplyShader(benchmark::State& state) {
+  const int size = int(state.range(0));
+  std::vector<Elements> lines;
+  // Every cell is 4 columns wide and 3 lines tall.
+  for (int y = 0; y < size / 3; ++y) {
+    Elements line;
+    for (int x = 0; x < size / 4; ++x) {
+      line.push_back(text(std::to_string(10 + (x + y) % 90)) | border);
+    }
+    lines.push_back(std::move(line));
+  }
+  auto document = gridbox(std::move(lines)) | border;
+  Screen screen(size, size);
+  Render(screen, document);
+  while (state.KeepRunning()) {
+    // Draw the unmerged characters again, using the layout already computed.
+    state.PauseTiming();
+    screen.Clear();
+    document->Render(screen);
+    state.ResumeTiming();
+    screen.ApplyShader();
+  }
+}
+BENCHMARK(BenchmarkApplyShader)->RangeMultiplier(2)->Range(50, 400);
+
+// Measure the output size of a border heavy layout, with and without the REP
+// and EL sequences.
+static void BenchmarkOutputCompression(benchmark::State& state) {
+  Elements rows;
+  for (int i = 0; i < 10; ++i) {
+    rows.push_back(hbox({
+        text("Label " + std::to_string(i)) | border,
+        gauge(0.1f * float(i)) | flex | border,
+        filler(),
+    }));
+    rows.push_back(separator());
+  }
+  auto document = vbox(std::move(rows)) | border;
+  Screen screen(state.range(0), state.range(0));
+  Render(screen, document);
+
+  Screen::OutputOptions options;
+  options.repeat = state.range(1);
+  options.erase_line = state.range(1);
+  std::string out;
+  while (state.KeepRunning()) {
+    out.clear();
+    screen.ToString(out, options);
+  }
+  state.counters["bytes"] = out.size();
+}
+BENCHMARK(BenchmarkOutputCompression)
+    ->ArgsProduct({
+        {80, 200, 400},  // Screen size.
+        {0, 1},          // Compression.
+    });
+
 }  // namespace ftxui
 // NOLINTEND
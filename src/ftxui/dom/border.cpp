@@ -1,16 +1,18 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for max
+#include <algorithm>  // for max, min
 #include <array>      // for array
 #include <cassert>
 #include <ftxui/screen/color.hpp>  // for Color
-#include <memory>    // for allocator, make_shared, __shared_ptr_access
+#include <initializer_list>        // for initializer_list
+#include <memory>    // for allocator, __shared_ptr_access
 #include <optional>  // for optional, nullopt
 #include <string>    // for basic_string, string
 #include <utility>   // for move
 #include <vector>    // for __alloc_traits<>::value_type
 
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
 #include "ftxui/dom/elements.hpp"  // for unpack, Element, Decorator, BorderStyle, ROUNDED, borderStyled, Elements, DASHED, DOUBLE, EMPTY, HEAVY, LIGHT, border, borderDashed, borderDouble, borderEmpty, borderHeavy, borderLight, borderRounded, borderWith, window
 #include "ftxui/dom/node.hpp"      // for Node, Elements
 #include "ftxui/dom/requirement.hpp"  // for Requirement
@@ -120,15 +122,24 @@ class Border : public Node {
     screen.at(box_.x_min, box_.y_max) = charset_[2];  // NOLINT
     screen.at(box_.x_max, box_.y_max) = charset_[3];  // NOLINT
 
-    for (int x = box_.x_min + 1; x < box_.x_max; ++x) {
-      Pixel& p1 = screen.PixelAt(x, box_.y_min);
-      Pixel& p2 = screen.PixelAt(x, box_.y_max);
-      p1.character = charset_[4];  // NOLINT
-      p2.character = charset_[4];  // NOLINT
-      p1.automerge = true;
-      p2.automerge = true;
+    // Draw the horizontal edges.
+    const Box& stencil = screen.stencil;
+    const int x_min = std::max(box_.x_min + 1, stencil.x_min);
+    const int x_max = std::min(box_.x_max - 1, stencil.x_max);
+    for (const int y : {box_.y_min, box_.y_max}) {
+      if (y < stencil.y_min || y > stencil.y_max) {
+        continue;
+      }
+      Pixel* row = screen.Row(y);
+      for (int x = x_min; x <= x_max; ++x) {
+        row[x].character = charset_[4];  // NOLINT
+        row[x].automerge = true;
+      }
     }
-    for (int y = box_.y_min + 1; y < box_.y_max; ++y) {
+    // Draw the vertical edges, on the lines inside of the stencil.
+    const int y_min = std::max(box_.y_min + 1, stencil.y_min);
+    const int y_max = std::min(box_.y_max - 1, stencil.y_max);
+    for (int y = y_min; y <= y_max; ++y) {
       if (children_.size() == 1 &&
           (charset_ == simple_border_charset[CONTAINER_HOLLOW_LIGHT] ||
            charset_ == simple_border_charset[CONTAINER_HOLLOW_HEAVY])) {
@@ -179,9 +190,9 @@ class Border : public Node {
         } else {
           Pixel& pl = screen.PixelAt(box_.x_min, y);
           Pixel& pr = screen.PixelAt(box_.x_max, y);
-          pl.character = left_().at(y % left_size_);
+          pl.character = std::string(1, left_().at(y % left_size_));
           pl.automerge = true;
-          pr.character = right_().at(y % right_size_);
+          pr.character = std::string(1, right_().at(y % right_size_));
           pr.automerge = true;
           continue;
         }
@@ -201,9 +212,15 @@ class Border : public Node {
 
     // Draw the border color.
     if (foreground_color_) {
-      for (int x = box_.x_min; x <= box_.x_max; ++x) {
-        screen.PixelAt(x, box_.y_min).foreground_color = *foreground_color_;
-        screen.PixelAt(x, box_.y_max).foreground_color = *foreground_color_;
+      const Box box = Box::Intersection(box_, stencil);
+      for (const int y : {box_.y_min, box_.y_max}) {
+        if (y < stencil.y_min || y > stencil.y_max) {
+          continue;
+        }
+        Pixel* row = screen.Row(y);
+        for (int x = box.x_min; x <= box.x_max; ++x) {
+          row[x].foreground_color = *foreground_color_;
+        }
       }
       for (int y = box_.y_min; y <= box_.y_max; ++y) {
         screen.PixelAt(box_.x_min, y).foreground_color = *foreground_color_;
@@ -272,7 +289,9 @@ class BorderPixel : public Node {
       screen.PixelAt(x, box_.y_min) = pixel_;
       screen.PixelAt(x, box_.y_max) = pixel_;
     }
-    for (int y = box_.y_min + 1; y < box_.y_max; ++y) {
+    const int y_min = std::max(box_.y_min + 1, screen.stencil.y_min);
+    const int y_max = std::min(box_.y_max - 1, screen.stencil.y_max);
+    for (int y = y_min; y <= y_max; ++y) {
       screen.PixelAt(box_.x_min, y) = pixel_;
       screen.PixelAt(box_.x_max, y) = pixel_;
     }
@@ -312,7 +331,7 @@ class BorderPixel : public Node {
 /// └───────────┘
 /// ```
 Element border(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), ROUNDED);
+  return MakeElement<Border>(unpack(std::move(child)), ROUNDED);
 }
 
 /// @brief Same as border but with a constant Pixel around the element.
@@ -320,7 +339,7 @@ Element border(Element child) {
 /// @see border
 Decorator borderWith(const Pixel& pixel) {
   return [pixel](Element child) {
-    return std::make_shared<BorderPixel>(unpack(std::move(child)), pixel);
+    return MakeElement<BorderPixel>(unpack(std::move(child)), pixel);
   };
 }
 
@@ -329,7 +348,7 @@ Decorator borderWith(const Pixel& pixel) {
 /// @see border
 Decorator borderStyled(BorderStyle style) {
   return [style](Element child) {
-    return std::make_shared<Border>(unpack(std::move(child)), style);
+    return MakeElement<Border>(unpack(std::move(child)), style);
   };
 }
 
@@ -338,7 +357,7 @@ Decorator borderStyled(BorderStyle style) {
 /// @see border
 Decorator borderStyled(Color foreground_color) {
   return [foreground_color](Element child) {
-    return std::make_shared<Border>(unpack(std::move(child)), ROUNDED,
+    return MakeElement<Border>(unpack(std::move(child)), ROUNDED,
                                     foreground_color);
   };
 }
@@ -348,7 +367,7 @@ Decorator borderStyled(Color foreground_color) {
 /// @see border
 Decorator borderStyled(BorderStyle style, Color foreground_color) {
   return [style, foreground_color](Element child) {
-    return std::make_shared<Border>(unpack(std::move(child)), style,
+    return MakeElement<Border>(unpack(std::move(child)), style,
                                     foreground_color);
   };
 }
@@ -385,7 +404,7 @@ Decorator borderStyled(BorderStyle style, Color foreground_color) {
 /// ┗╍╍╍╍╍╍╍╍╍╍╍╍╍╍┛
 /// ```
 Element borderDashed(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), DASHED);
+  return MakeElement<Border>(unpack(std::move(child)), DASHED);
 }
 
 /// @brief Draw a dashed border around the element.
@@ -420,7 +439,7 @@ Element borderDashed(Element child) {
 /// └──────────────┘
 /// ```
 Element borderLight(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), LIGHT);
+  return MakeElement<Border>(unpack(std::move(child)), LIGHT);
 }
 
 /// @brief Draw a heavy border around the element.
@@ -455,7 +474,7 @@ Element borderLight(Element child) {
 /// ┗━━━━━━━━━━━━━━┛
 /// ```
 Element borderHeavy(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), HEAVY);
+  return MakeElement<Border>(unpack(std::move(child)), HEAVY);
 }
 
 /// @brief Draw a double border around the element.
@@ -490,7 +509,7 @@ Element borderHeavy(Element child) {
 /// ╚══════════════╝
 /// ```
 Element borderDouble(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), DOUBLE);
+  return MakeElement<Border>(unpack(std::move(child)), DOUBLE);
 }
 
 /// @brief Draw a rounded border around the element.
@@ -525,7 +544,7 @@ Element borderDouble(Element child) {
 /// ╰──────────────╯
 /// ```
 Element borderRounded(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), ROUNDED);
+  return MakeElement<Border>(unpack(std::move(child)), ROUNDED);
 }
 
 /// @brief Draw an empty border around the element.
@@ -560,21 +579,21 @@ Element borderRounded(Element child) {
 ///
 /// ```
 Element borderEmpty(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), EMPTY);
+  return MakeElement<Border>(unpack(std::move(child)), EMPTY);
 }
 
 Element borderHollowLight(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), HOLLOW_LIGHT);
+  return MakeElement<Border>(unpack(std::move(child)), HOLLOW_LIGHT);
 }
 
 Element borderHollowHeavy(Element child) {
-  return std::make_shared<Border>(unpack(std::move(child)), HOLLOW_HEAVY);
+  return MakeElement<Border>(unpack(std::move(child)), HOLLOW_HEAVY);
 }
 
 Decorator borderContainerHollowLight(StringRef left_container_text,
                                      StringRef right_container_text) {
   return [left_container_text, right_container_text](Element child) {
-    return std::make_shared<Border>(unpack(std::move(child)),
+    return MakeElement<Border>(unpack(std::move(child)),
                                     CONTAINER_HOLLOW_LIGHT, std::nullopt,
                                     left_container_text, right_container_text);
   };
@@ -583,7 +602,7 @@ Decorator borderContainerHollowLight(StringRef left_container_text,
 Decorator borderContainerHollowHeavy(StringRef left_container_text,
                                      StringRef right_container_text) {
   return [left_container_text, right_container_text](Element child) {
-    return std::make_shared<Border>(unpack(std::move(child)),
+    return MakeElement<Border>(unpack(std::move(child)),
                                     CONTAINER_HOLLOW_HEAVY, std::nullopt,
                                     left_container_text, right_container_text);
   };
@@ -611,7 +630,7 @@ Decorator borderContainerHollowHeavy(StringRef left_container_text,
 /// └───────┘
 /// ```
 Element window(Element title, Element content) {
-  return std::make_shared<Border>(unpack(std::move(content), std::move(title)),
+  return MakeElement<Border>(unpack(std::move(content), std::move(title)),
                                   ROUNDED);
 }
 }  // namespace ftxui
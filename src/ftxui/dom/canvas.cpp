@@ -9,16 +9,17 @@
 #include <cstdlib>                 // for abs
 #include <ftxui/screen/color.hpp>  // for Color
 #include <map>                     // for map
-#include <memory>                  // for make_shared
+#include <memory>                  // for shared_ptr
 #include <utility>                 // for move, pair
 #include <vector>                  // for vector
 
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
 #include "ftxui/dom/elements.hpp"     // for Element, canvas
 #include "ftxui/dom/node.hpp"         // for Node
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/screen.hpp"    // for Pixel, Screen
-#include "ftxui/screen/string.hpp"    // for Utf8ToGlyphs
+#include "ftxui/screen/string.hpp"    // for Utf8Glyphs, GlyphView
 #include "ftxui/util/ref.hpp"         // for ConstRef
 
 namespace ftxui {
@@ -141,8 +142,10 @@ void Canvas::DrawPointOn(int x, int y) {
     cell.type = CellType::kBraille;
   }
 
-  cell.content.character[1] |= g_map_braille[x % 2][y % 4][0];  // NOLINT
-  cell.content.character[2] |= g_map_braille[x % 2][y % 4][1];  // NOLINT
+  std::string braille = cell.content.character;
+  braille[1] |= g_map_braille[x % 2][y % 4][0];  // NOLINT
+  braille[2] |= g_map_braille[x % 2][y % 4][1];  // NOLINT
+  cell.content.character = braille;
 }
 
 /// @brief Erase a braille dot.
@@ -158,8 +161,10 @@ void Canvas::DrawPointOff(int x, int y) {
     cell.type = CellType::kBraille;
   }
 
-  cell.content.character[1] &= ~(g_map_braille[x % 2][y % 4][0]);  // NOLINT
-  cell.content.character[2] &= ~(g_map_braille[x % 2][y % 4][1]);  // NOLINT
+  std::string braille = cell.content.character;
+  braille[1] &= ~(g_map_braille[x % 2][y % 4][0]);  // NOLINT
+  braille[2] &= ~(g_map_braille[x % 2][y % 4][1]);  // NOLINT
+  cell.content.character = braille;
 }
 
 /// @brief Toggle a braille dot. A filled one will be erased, and the other will
@@ -176,8 +181,10 @@ void Canvas::DrawPointToggle(int x, int y) {
     cell.type = CellType::kBraille;
   }
 
-  cell.content.character[1] ^= g_map_braille[x % 2][y % 4][0];  // NOLINT
-  cell.content.character[2] ^= g_map_braille[x % 2][y % 4][1];  // NOLINT
+  std::string braille = cell.content.character;
+  braille[1] ^= g_map_braille[x % 2][y % 4][0];  // NOLINT
+  braille[2] ^= g_map_braille[x % 2][y % 4][1];  // NOLINT
+  cell.content.character = braille;
 }
 
 /// @brief Draw a line made of braille dots.
@@ -804,14 +811,14 @@ void Canvas::DrawText(int x,
                       int y,
                       const std::string& value,
                       const Stylizer& style) {
-  for (const auto& it : Utf8ToGlyphs(value)) {
+  for (const GlyphView& glyph : Utf8Glyphs(value)) {
     if (!IsIn(x, y)) {
       x += 2;
       continue;
     }
     Cell& cell = storage_[XY{x / 2, y / 4}];
     cell.type = CellType::kText;
-    cell.content.character = it;
+    cell.content.character = glyph.text;
     style(cell.content);
     x += 2;
   }
@@ -859,7 +866,7 @@ Element canvas(ConstRef<Canvas> canvas) {
     const Canvas& canvas() final { return *canvas_; }
     ConstRef<Canvas> canvas_;
   };
-  return std::make_shared<Impl>(canvas);
+  return MakeElement<Impl>(canvas);
 }
 
 /// @brief Produce an element drawing a canvas of requested size.
@@ -891,7 +898,7 @@ Element canvas(int width, int height, std::function<void(Canvas&)> fn) {
     int height_;
     std::function<void(Canvas&)> fn_;
   };
-  return std::make_shared<Impl>(width, height, std::move(fn));
+  return MakeElement<Impl>(width, height, std::move(fn));
 }
 
 /// @brief Produce an element drawing a canvas.
@@ -2,10 +2,11 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <algorithm>  // for max
-#include <memory>     // for __shared_ptr_access, shared_ptr, make_shared
+#include <memory>     // for __shared_ptr_access, shared_ptr
 #include <utility>    // for move
 #include <vector>     // for vector
 
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
 #include "ftxui/dom/elements.hpp"     // for Element, Elements, dbox
 #include "ftxui/dom/node.hpp"         // for Node, Elements
 #include "ftxui/dom/requirement.hpp"  // for Requirement
@@ -55,7 +56,7 @@ class DBox : public Node {
 /// @return The right aligned element.
 /// @ingroup dom
 Element dbox(Elements children_) {
-  return std::make_shared<DBox>(std::move(children_));
+  return MakeElement<DBox>(std::move(children_));
 }
 
 }  // namespace ftxui
@@ -0,0 +1,109 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>  // for max
+#include <atomic>     // for atomic, memory_order_acq_rel, ...
+#include <cstddef>    // for size_t, max_align_t
+#include <new>        // for operator new, operator delete
+
+#include "ftxui/dom/element_arena.hpp"
+
+namespace ftxui {
+
+namespace {
+
+constexpr size_t kAlignment = alignof(std::max_align_t);
+
+// Every allocation is preceded by a pointer to its block.
+constexpr size_t kHeaderSize = kAlignment;
+
+constexpr size_t kBlockSize = size_t(64) * 1024;
+
+thread_local ElementArena* g_current = nullptr;  // NOLINT
+
+constexpr size_t Align(size_t size) {
+  return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+}  // namespace
+
+struct ElementArena::Block {
+  explicit Block(size_t capacity) : size(capacity) {}
+
+  static Block* New(size_t size) {
+    void* memory = ::operator new(Align(sizeof(Block)) + size);
+    return new (memory) Block(size);
+  }
+
+  // Delete the block once the arena and every allocation are gone.
+  void Release() {
+    if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      this->~Block();
+      ::operator delete(this);
+    }
+  }
+
+  char* data() { return reinterpret_cast<char*>(this) + Align(sizeof(Block)); }
+
+  // One reference for the arena, and one per allocation alive.
+  std::atomic<size_t> references{1};
+  const size_t size;
+  size_t used = 0;
+};
+
+ElementArena::ElementArena() = default;
+
+ElementArena::~ElementArena() {
+  for (Block* block : blocks_) {
+    block->Release();
+  }
+}
+
+/// @brief Reuse the memory of the elements destroyed so far. The blocks still
+/// used by elements alive are kept as is.
+void ElementArena::Reset() {
+  for (Block* block : blocks_) {
+    if (block->references.load(std::memory_order_acquire) == 1) {
+      block->used = 0;
+    }
+  }
+  current_ = 0;
+}
+
+void* ElementArena::Allocate(size_t size) {
+  const size_t needed = kHeaderSize + Align(size);
+  while (current_ < blocks_.size() &&
+         blocks_[current_]->used + needed > blocks_[current_]->size) {
+    current_++;
+  }
+  if (current_ == blocks_.size()) {
+    blocks_.push_back(Block::New(std::max(kBlockSize, needed)));
+  }
+
+  Block* block = blocks_[current_];
+  char* header = block->data() + block->used;
+  block->used += needed;
+  block->references.fetch_add(1, std::memory_order_relaxed);
+  new (header) Block*(block);
+  return header + kHeaderSize;
+}
+
+void ElementArena::Deallocate(void* pointer) {
+  char* header = static_cast<char*>(pointer) - kHeaderSize;
+  (*reinterpret_cast<Block**>(header))->Release();
+}
+
+/// @brief The arena in use on this thread, or nullptr.
+ElementArena* ElementArena::Current() {
+  return g_current;
+}
+
+ElementArena::Scope::Scope(ElementArena* arena) : previous_(g_current) {
+  g_current = arena;
+}
+
+ElementArena::Scope::~Scope() {
+  g_current = previous_;
+}
+
+}  // namespace ftxui
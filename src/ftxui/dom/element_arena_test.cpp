@@ -0,0 +1,96 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <memory>  // for make_unique
+#include <string>  // for allocator, string, to_string
+
+#include "ftxui/dom/element_arena.hpp"  // for ElementArena
+#include "ftxui/dom/elements.hpp"       // for text, vbox, border, memo, ...
+#include "ftxui/dom/node.hpp"           // for Render
+#include "ftxui/screen/screen.hpp"      // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+Element Document(int frame) {
+  Elements rows;
+  for (int i = 0; i < 3; ++i) {
+    rows.push_back(text(std::to_string(frame * 10 + i)));
+  }
+  return vbox(std::move(rows)) | border;
+}
+
+std::string Draw(const Element& document) {
+  Screen screen(4, 5);
+  Render(screen, document);
+  return screen.ToString();
+}
+}  // namespace
+
+TEST(ElementArenaTest, Scope) {
+  ElementArena arena;
+  EXPECT_EQ(ElementArena::Current(), nullptr);
+  {
+    const ElementArena::Scope scope(&arena);
+    EXPECT_EQ(ElementArena::Current(), &arena);
+    {
+      const ElementArena::Scope heap(nullptr);
+      EXPECT_EQ(ElementArena::Current(), nullptr);
+    }
+    EXPECT_EQ(ElementArena::Current(), &arena);
+  }
+  EXPECT_EQ(ElementArena::Current(), nullptr);
+}
+
+TEST(ElementArenaTest, Frames) {
+  ElementArena arena;
+  for (int frame = 0; frame < 100; ++frame) {
+    arena.Reset();
+    const ElementArena::Scope scope(&arena);
+    EXPECT_EQ(Draw(Document(frame)), Draw(Document(frame)));
+  }
+  const std::string expected =
+      "╭──╮\r\n"
+      "│50│\r\n"
+      "│51│\r\n"
+      "│52│\r\n"
+      "╰──╯";
+  EXPECT_EQ(Draw(Document(5)), expected);
+}
+
+// The elements kept in between frames stay valid.
+TEST(ElementArenaTest, KeptElements) {
+  ElementArena arena;
+  MemoKey key;
+  Element kept;
+  for (int frame = 0; frame < 100; ++frame) {
+    arena.Reset();
+    const ElementArena::Scope scope(&arena);
+    if (frame == 1) {
+      kept = Document(frame);
+    }
+    auto memoized = memo(key, frame / 10, [&] { return Document(frame); });
+    EXPECT_EQ(Draw(memoized), Draw(Document(frame / 10 * 10)));
+    Document(frame);  // Allocate over the memory of the previous frame.
+    if (kept) {
+      EXPECT_EQ(Draw(kept), Draw(Document(1)));
+    }
+  }
+}
+
+// The elements can outlive the arena.
+TEST(ElementArenaTest, OutliveArena) {
+  Element kept;
+  auto arena = std::make_unique<ElementArena>();
+  {
+    const ElementArena::Scope scope(arena.get());
+    kept = Document(1);
+  }
+  arena.reset();
+  EXPECT_EQ(Draw(kept), Draw(Document(1)));
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -2,9 +2,10 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <ftxui/dom/direction.hpp>  // for Direction, Direction::Down, Direction::Left, Direction::Right, Direction::Up
-#include <memory>                   // for allocator, make_shared
+#include <memory>                   // for allocator
 #include <string>                   // for string
 
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
 #include "ftxui/dom/elements.hpp"  // for Element, gauge, gaugeDirection, gaugeDown, gaugeLeft, gaugeRight, gaugeUp
 #include "ftxui/dom/node.hpp"         // for Node
 #include "ftxui/dom/requirement.hpp"  // for Requirement
@@ -99,6 +100,11 @@ class Gauge : public Node {
     if (y > box_.y_max) {
       return;
     }
+    const Box box = Box::Intersection(box_, screen.stencil);
+    if (y < box.y_min || y > box.y_max) {
+      return;
+    }
+    Pixel* row = screen.Row(y);
 
     // Draw the progress bar horizontally.
     {
@@ -106,20 +112,18 @@ class Gauge : public Node {
       const auto limit =
           float(box_.x_min) + progress * float(box_.x_max - box_.x_min + 1);
       const int limit_int = static_cast<int>(limit);
-      int x = box_.x_min;
-      while (x < limit_int) {
-        screen.at(x++, y) = charset_horizontal[9];  // NOLINT
-      }
-      // NOLINTNEXTLINE
-      screen.at(x++, y) = charset_horizontal[int(9 * (limit - limit_int))];
-      while (x <= box_.x_max) {
-        screen.at(x++, y) = charset_horizontal[0];
+      const std::string& partial =
+          charset_horizontal[int(9 * (limit - limit_int))];  // NOLINT
+      for (int x = box.x_min; x <= box.x_max; ++x) {
+        row[x].character = x < limit_int    ? charset_horizontal[9]  // NOLINT
+                           : x == limit_int ? partial
+                                            : charset_horizontal[0];
       }
     }
 
     if (invert) {
-      for (int x = box_.x_min; x <= box_.x_max; x++) {
-        screen.PixelAt(x, y).inverted ^= true;
+      for (int x = box.x_min; x <= box.x_max; x++) {
+        row[x].inverted ^= true;
       }
     }
   }
@@ -129,6 +133,10 @@ class Gauge : public Node {
     if (x > box_.x_max) {
       return;
     }
+    const Box box = Box::Intersection(box_, screen.stencil);
+    if (x < box.x_min || x > box.x_max) {
+      return;
+    }
 
     // Draw the progress bar vertically:
     {
@@ -136,20 +144,19 @@ class Gauge : public Node {
       const float limit =
           float(box_.y_min) + progress * float(box_.y_max - box_.y_min + 1);
       const int limit_int = static_cast<int>(limit);
-      int y = box_.y_min;
-      while (y < limit_int) {
-        screen.at(x, y++) = charset_vertical[8];  // NOLINT
-      }
-      // NOLINTNEXTLINE
-      screen.at(x, y++) = charset_vertical[int(8 * (limit - limit_int))];
-      while (y <= box_.y_max) {
-        screen.at(x, y++) = charset_vertical[0];
+      const std::string& partial =
+          charset_vertical[int(8 * (limit - limit_int))];  // NOLINT
+      for (int y = box.y_min; y <= box.y_max; ++y) {
+        screen.Row(y)[x].character =
+            y < limit_int    ? charset_vertical[8]  // NOLINT
+            : y == limit_int ? partial
+                             : charset_vertical[0];
       }
     }
 
     if (invert) {
-      for (int y = box_.y_min; y <= box_.y_max; y++) {
-        screen.PixelAt(x, y).inverted ^= true;
+      for (int y = box.y_min; y <= box.y_max; y++) {
+        screen.Row(y)[x].inverted ^= true;
       }
     }
   }
@@ -167,7 +174,7 @@ class Gauge : public Node {
 //  @param direction Direction of progress bars progression.
 /// @ingroup dom
 Element gaugeDirection(float progress, Direction direction) {
-  return std::make_shared<Gauge>(progress, direction);
+  return MakeElement<Gauge>(progress, direction);
 }
 
 /// @brief Draw a high definition progress bar progressing from left to right.
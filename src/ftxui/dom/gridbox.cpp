@@ -3,11 +3,12 @@
 // the LICENSE file.
 #include <algorithm>  // for max, min
 #include <cstddef>    // for size_t
-#include <memory>  // for __shared_ptr_access, shared_ptr, make_shared, allocator_traits<>::value_type
+#include <memory>  // for __shared_ptr_access, shared_ptr, allocator_traits<>::value_type
 #include <utility>  // for move
 #include <vector>   // for vector, __alloc_traits<>::value_type
 
 #include "ftxui/dom/box_helper.hpp"   // for Element, Compute
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
 #include "ftxui/dom/elements.hpp"     // for Elements, filler, Element, gridbox
 #include "ftxui/dom/node.hpp"         // for Node
 #include "ftxui/dom/requirement.hpp"  // for Requirement
@@ -143,7 +144,7 @@ class GridBox : public Node {
   void Render(Screen& screen) override {
     for (auto& line : lines_) {
       for (auto& cell : line) {
-        cell->Render(screen);
+        RenderChild(screen, cell.get());
       }
     }
   }
@@ -181,7 +182,7 @@ class GridBox : public Node {
 /// ╰──────────╯╰──────╯╰──────────╯
 /// ```
 Element gridbox(std::vector<Elements> lines) {
-  return std::make_shared<GridBox>(std::move(lines));
+  return MakeElement<GridBox>(std::move(lines));
 }
 
 }  // namespace ftxui
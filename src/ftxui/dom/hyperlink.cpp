@@ -1,11 +1,12 @@
 // Copyright 2023 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <cstdint>  // for uint8_t
-#include <memory>   // for make_shared
+#include <cstdint>  // for uint16_t
+#include <memory>   // for shared_ptr
 #include <string>   // for string
 #include <utility>  // for move
 
+#include "ftxui/dom/element_arena.hpp"   // for MakeElement
 #include "ftxui/dom/elements.hpp"        // for Element, Decorator, hyperlink
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
 #include "ftxui/screen/box.hpp"          // for Box
@@ -20,10 +21,12 @@ class Hyperlink : public NodeDecorator {
       : NodeDecorator(std::move(child)), link_(std::move(link)) {}
 
   void Render(Screen& screen) override {
-    const uint8_t hyperlink_id = screen.RegisterHyperlink(link_);
-    for (int y = box_.y_min; y <= box_.y_max; ++y) {
-      for (int x = box_.x_min; x <= box_.x_max; ++x) {
-        screen.PixelAt(x, y).hyperlink = hyperlink_id;
+    const uint16_t hyperlink_id = screen.RegisterHyperlink(link_);
+    const Box box = Box::Intersection(box_, screen.stencil);
+    for (int y = box.y_min; y <= box.y_max; ++y) {
+      Pixel* row = screen.Row(y);
+      for (int x = box.x_min; x <= box.x_max; ++x) {
+        row[x].hyperlink = hyperlink_id;
       }
     }
     NodeDecorator::Render(screen);
@@ -49,7 +52,7 @@ class Hyperlink : public NodeDecorator {
 ///   hyperlink("https://github.com/ArthurSonzogni/FTXUI", "link");
 /// ```
 Element hyperlink(std::string link, Element child) {
-  return std::make_shared<Hyperlink>(std::move(child), std::move(link));
+  return MakeElement<Hyperlink>(std::move(child), std::move(link));
 }
 
 /// @brief Decorate using an hyperlink.
@@ -0,0 +1,182 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>  // for copy_n
+#include <cstdint>    // for uint16_t
+#include <memory>     // for shared_ptr
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "ftxui/dom/element_arena.hpp"   // for MakeElement
+#include "ftxui/dom/elements.hpp"        // for Decorator, Element, LayerKey
+#include "ftxui/dom/node.hpp"            // for Node, Node::Status
+#include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/dom/requirement.hpp"     // for Requirement
+#include "ftxui/screen/box.hpp"          // for Box
+#include "ftxui/screen/screen.hpp"       // for Pixel, Screen
+
+namespace ftxui {
+
+namespace {
+
+// Draw the child into the pixels of the key, and copy them into the screen.
+// While the key is up to date, the child isn't laid out nor drawn.
+class Layer : public NodeDecorator {
+ public:
+  Layer(Element child, LayerKey& key, int version)
+      : NodeDecorator(std::move(child)), key_(key) {
+    if (key_.version != version) {
+      key_.version = version;
+      key_.drawn = false;
+    }
+  }
+
+  void Check(Status* status) override {
+    if (status->iteration == 0) {
+      cached_ = key_.drawn;
+      if (cached_) {
+        requirement_ = key_.requirement;
+      }
+    }
+
+    if (!cached_) {
+      Node::Check(status);
+      return;
+    }
+
+    status->need_iteration |= (status->iteration == 0) || need_iteration_;
+    need_iteration_ = false;
+  }
+
+  void ComputeRequirement() override {
+    if (!cached_) {
+      NodeDecorator::ComputeRequirement();
+    }
+  }
+
+  void SetBox(Box box) override {
+    if (!cached_) {
+      NodeDecorator::SetBox(box);
+      return;
+    }
+
+    Node::SetBox(box);
+    if (SameSize()) {
+      return;
+    }
+
+    // The pixels are drawn again for the new size. If this changes the
+    // requirement of the child, the parent needs another iteration.
+    Layout(children_[0].get(), box);
+    if (children_[0]->requirement() != requirement_) {
+      requirement_ = children_[0]->requirement();
+      need_iteration_ = true;
+    }
+  }
+
+  void Render(Screen& screen) override {
+    if (box_.x_min > box_.x_max || box_.y_min > box_.y_max) {
+      return;
+    }
+    if (!cached_ || !SameSize()) {
+      Draw();
+    }
+    Blit(screen);
+  }
+
+ private:
+  bool SameSize() const {
+    return key_.pixels.dimx() == box_.x_max - box_.x_min + 1 &&
+           key_.pixels.dimy() == box_.y_max - box_.y_min + 1;
+  }
+
+  void Draw() {
+    Screen& pixels = key_.pixels;
+    if (SameSize()) {
+      pixels.Clear();
+    } else {
+      pixels.Resize(box_.x_max - box_.x_min + 1, box_.y_max - box_.y_min + 1);
+    }
+
+    // Draw the child moved to the origin of the pixels.
+    Box moved = box_;
+    moved.x_min -= box_.x_min;
+    moved.x_max -= box_.x_min;
+    moved.y_min -= box_.y_min;
+    moved.y_max -= box_.y_min;
+    children_[0]->SetBox(moved);
+    pixels.stencil = moved;
+    children_[0]->Render(pixels);
+
+    key_.requirement = requirement_;
+    key_.drawn = true;
+  }
+
+  // Copy the visible part of the pixels, a row at a time. The box characters
+  // are merged by the screen afterward, like the ones drawn directly.
+  void Blit(Screen& screen) {
+    // Like for PixelAt(), the stencil is contained in the screen.
+    const Box area = Box::Intersection(box_, screen.stencil);
+    const int width = area.x_max - area.x_min + 1;
+    if (width <= 0) {
+      return;
+    }
+
+    const Screen& pixels = key_.pixels;
+    std::vector<uint16_t> hyperlinks;
+    for (int y = area.y_min; y <= area.y_max; ++y) {
+      const Pixel* from =
+          pixels.Row(y - box_.y_min) + (area.x_min - box_.x_min);
+      Pixel* to = screen.Row(y) + area.x_min;
+      std::copy_n(from, width, to);
+
+      // The hyperlinks are identified differently in the screen.
+      for (int x = 0; x < width; ++x) {
+        const uint16_t id = to[x].hyperlink;
+        if (id == 0) {
+          continue;
+        }
+        if (hyperlinks.size() <= id) {
+          hyperlinks.resize(id + 1, 0);
+        }
+        if (hyperlinks[id] == 0) {
+          hyperlinks[id] = screen.RegisterHyperlink(pixels.Hyperlink(id));
+        }
+        to[x].hyperlink = hyperlinks[id];
+      }
+    }
+  }
+
+  LayerKey& key_;
+  bool cached_ = false;
+  bool need_iteration_ = false;
+};
+
+}  // namespace
+
+/// @brief Draw an element into |key|, and copy its pixels on the next frames,
+/// as long as |version| and its size are unchanged. Meanwhile, the element
+/// isn't laid out nor drawn.
+/// @param key Where the pixels are kept in between frames.
+/// @param version Must change whenever the element would be drawn differently.
+/// @ingroup dom
+///
+/// This is meant for static content, like a help panel, or a large canvas
+/// updated from time to time. The layer hides what is drawn below it. The
+/// elements inside are drawn at the origin of the layer, so they shouldn't
+/// `reflect` their box, or set the cursor.
+///
+/// ### Example
+///
+/// ```cpp
+/// LayerKey plot_key;
+/// ...
+/// Element plot = canvas(BuildPlot()) | layer(plot_key, plot_version);
+/// ```
+Decorator layer(LayerKey& key, int version) {
+  return [&key, version](Element child) -> Element {
+    return MakeElement<Layer>(std::move(child), key, version);
+  };
+}
+
+}  // namespace ftxui
@@ -0,0 +1,115 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <string>  // for allocator, string, to_string
+
+#include "ftxui/dom/elements.hpp"   // for layer, LayerKey, text, border, ...
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(LayerTest, Version) {
+  LayerKey key;
+  Screen screen(7, 1);
+  Render(screen, text("first") | layer(key, 0));
+  EXPECT_EQ(screen.ToString(), "first  ");
+
+  // The pixels are reused, as long as the version is unchanged.
+  Render(screen, text("second") | layer(key, 0));
+  EXPECT_EQ(screen.ToString(), "first  ");
+
+  Render(screen, text("second") | layer(key, 1));
+  EXPECT_EQ(screen.ToString(), "second ");
+}
+
+TEST(LayerTest, Automerge) {
+  auto document = [](Decorator decorator) {
+    return vbox({
+               hbox({text("a"), separator(), text("b")}) | decorator,
+               separator(),
+               text("c"),
+           }) |
+           border;
+  };
+  Screen reference(5, 5);
+  Render(reference, document(nothing));
+  EXPECT_EQ(reference.ToString(),
+            "╭─┬─╮\r\n"
+            "│a│b│\r\n"
+            "├─┴─┤\r\n"
+            "│c  │\r\n"
+            "╰───╯");
+
+  LayerKey key;
+  for (int i = 0; i < 2; ++i) {
+    Screen screen(5, 5);
+    Render(screen, document(layer(key, 0)));
+    EXPECT_EQ(screen.ToString(), reference.ToString());
+  }
+}
+
+TEST(LayerTest, Resize) {
+  const std::string content = "aaa bbb ccc ddd eee";
+  LayerKey key;
+  auto document = [&](Decorator decorator) {
+    return vbox({
+        text("title"),
+        paragraph(content) | border | decorator,
+        text("end"),
+    });
+  };
+
+  for (int width : {20, 8, 6, 8, 12, 12, 20}) {
+    Screen screen(width, 10);
+    Render(screen, document(layer(key, 0)));
+    Screen reference(width, 10);
+    Render(reference, document(nothing));
+    EXPECT_EQ(screen.ToString(), reference.ToString()) << width;
+  }
+}
+
+TEST(LayerTest, Frame) {
+  auto rows = [] {
+    Elements children;
+    for (int i = 0; i < 10; ++i) {
+      children.push_back(text(std::to_string(i)));
+    }
+    return vbox(std::move(children));
+  };
+  LayerKey key;
+  for (int i = 0; i < 2; ++i) {
+    Screen screen(3, 5);
+    Render(screen, vbox({
+                       rows() | layer(key, 0),
+                       text("x") | focus,
+                   }) | frame |
+                       border);
+    EXPECT_EQ(screen.ToString(),
+              "╭─╮\r\n"
+              "│8│\r\n"
+              "│9│\r\n"
+              "│x│\r\n"
+              "╰─╯");
+  }
+}
+
+TEST(LayerTest, Hyperlink) {
+  LayerKey key;
+  for (int i = 0; i < 2; ++i) {
+    Screen screen(2, 1);
+    Render(screen, hbox({
+                       text("a") | hyperlink("https://a.com"),
+                       text("b") | hyperlink("https://b.com") | layer(key, 0),
+                   }));
+    EXPECT_EQ(screen.Hyperlink(screen.PixelAt(0, 0).hyperlink),
+              "https://a.com");
+    EXPECT_EQ(screen.Hyperlink(screen.PixelAt(1, 0).hyperlink),
+              "https://b.com");
+  }
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -5,11 +5,12 @@
 #include <cmath>                          // for fmod, cos, sin
 #include <cstddef>                        // for size_t
 #include <ftxui/dom/linear_gradient.hpp>  // for LinearGradient::Stop, LinearGradient
-#include <memory>    // for allocator_traits<>::value_type, make_shared
+#include <memory>    // for allocator_traits<>::value_type
 #include <optional>  // for optional, operator!=, operator<
 #include <utility>   // for move
 #include <vector>    // for vector
 
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
 #include "ftxui/dom/elements.hpp"  // for Element, Decorator, bgcolor, color
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
 #include "ftxui/screen/box.hpp"          // for Box
@@ -149,18 +150,21 @@ class LinearGradientColor : public NodeDecorator {
     const float dZ = -min / (max - min);
 
     // Project every pixel to get the color.
+    const Box box = Box::Intersection(box_, screen.stencil);
     if (background_color_) {
-      for (int y = box_.y_min; y <= box_.y_max; ++y) {
-        for (int x = box_.x_min; x <= box_.x_max; ++x) {
+      for (int y = box.y_min; y <= box.y_max; ++y) {
+        Pixel* row = screen.Row(y);
+        for (int x = box.x_min; x <= box.x_max; ++x) {
           const float t = float(x) * dX + float(y) * dY + dZ;
-          screen.PixelAt(x, y).background_color = Interpolate(gradient_, t);
+          row[x].background_color = Interpolate(gradient_, t);
         }
       }
     } else {
-      for (int y = box_.y_min; y <= box_.y_max; ++y) {
-        for (int x = box_.x_min; x <= box_.x_max; ++x) {
+      for (int y = box.y_min; y <= box.y_max; ++y) {
+        Pixel* row = screen.Row(y);
+        for (int x = box.x_min; x <= box.x_max; ++x) {
           const float t = float(x) * dX + float(y) * dY + dZ;
-          screen.PixelAt(x, y).foreground_color = Interpolate(gradient_, t);
+          row[x].foreground_color = Interpolate(gradient_, t);
         }
       }
     }
@@ -245,7 +249,7 @@ LinearGradient& LinearGradient::Stop(Color c) {
 /// color(LinearGradient{0, {Color::Red, Color::Blue}}, text("Hello"))
 /// ```
 Element color(const LinearGradient& gradient, Element child) {
-  return std::make_shared<LinearGradientColor>(std::move(child), gradient,
+  return MakeElement<LinearGradientColor>(std::move(child), gradient,
                                                /*background_color*/ false);
 }
 
@@ -261,7 +265,7 @@ Element color(const LinearGradient& gradient, Element child) {
 /// bgcolor(LinearGradient{0, {Color::Red, Color::Blue}}, text("Hello"))
 /// ```
 Element bgcolor(const LinearGradient& gradient, Element child) {
-  return std::make_shared<LinearGradientColor>(std::move(child), gradient,
+  return MakeElement<LinearGradientColor>(std::move(child), gradient,
                                                /*background_color*/ true);
 }
 
@@ -0,0 +1,107 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <functional>  // for function
+#include <memory>      // for __shared_ptr_access
+#include <utility>     // for move
+
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
+#include "ftxui/dom/elements.hpp"     // for Element, MemoKey, memo, unpack
+#include "ftxui/dom/node.hpp"         // for Node, Node::Status
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
+
+namespace ftxui {
+
+namespace {
+
+// The same node is returned by `memo` for as long as the version is unchanged.
+// Once its child has been laid out, the next frames reuse its requirement, and
+// its layout while the box is unchanged.
+class Memo : public Node {
+ public:
+  explicit Memo(Element child) : Node(unpack(std::move(child))) {}
+
+  void Check(Status* status) override {
+    if (status->iteration == 0) {
+      cached_ = laid_out_;
+    }
+
+    if (!cached_) {
+      Node::Check(status);
+      return;
+    }
+
+    status->need_iteration |= (status->iteration == 0) || need_iteration_;
+    need_iteration_ = false;
+  }
+
+  void ComputeRequirement() override {
+    if (cached_) {
+      return;
+    }
+    Node::ComputeRequirement();
+    requirement_ = children_[0]->requirement();
+  }
+
+  void SetBox(Box box) override {
+    if (!cached_) {
+      Node::SetBox(box);
+      children_[0]->SetBox(box);
+      laid_out_ = true;
+      return;
+    }
+
+    if (box == box_) {
+      return;
+    }
+
+    // The box changed: lay out the child again, on its own. If this changes
+    // its requirement, the parent needs another iteration.
+    Node::SetBox(box);
+    Layout(children_[0].get(), box);
+    if (children_[0]->requirement() != requirement_) {
+      requirement_ = children_[0]->requirement();
+      need_iteration_ = true;
+    }
+  }
+
+ private:
+  bool laid_out_ = false;
+  bool cached_ = false;
+  bool need_iteration_ = false;
+};
+
+}  // namespace
+
+/// @brief Build an element once, and reuse it in the next frames as long as
+/// its version is unchanged. Its layout is reused too, and computed again only
+/// when the box it is given changes.
+/// @param key Where the element is kept in between frames.
+/// @param version Must change whenever |builder| would build another element.
+/// @param builder Build the element.
+/// @ingroup dom
+///
+/// The element must be used only once per frame.
+///
+/// ### Example
+///
+/// ```cpp
+/// MemoKey help_key;
+/// ...
+/// Element help = memo(help_key, help_version, [&] {
+///   return vbox(BuildHelpLines()) | border;
+/// });
+/// ```
+Element memo(MemoKey& key,
+             int version,
+             const std::function<Element()>& builder) {
+  if (!key.element || key.version != version) {
+    key.element = MakeElement<Memo>(builder());
+    key.version = version;
+  }
+  return key.element;
+}
+
+}  // namespace ftxui
@@ -0,0 +1,127 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <memory>  // for make_shared
+#include <string>  // for allocator, string, to_string
+
+#include "ftxui/dom/elements.hpp"   // for memo, MemoKey, text, vbox, ...
+#include "ftxui/dom/node.hpp"       // for Node, Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+// Count the layout steps it goes through.
+class Counter : public Node {
+ public:
+  Counter(int* layouts) : layouts_(layouts) {}
+  void ComputeRequirement() override {
+    requirement_.min_x = 3;
+    requirement_.min_y = 1;
+  }
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    (*layouts_)++;
+  }
+
+ private:
+  int* layouts_;
+};
+
+}  // namespace
+
+TEST(MemoTest, Version) {
+  MemoKey key;
+  int built = 0;
+  auto build = [&] {
+    built++;
+    return text("build " + std::to_string(built));
+  };
+
+  Screen screen(7, 1);
+  Render(screen, memo(key, 0, build));
+  Render(screen, memo(key, 0, build));
+  EXPECT_EQ(built, 1);
+  EXPECT_EQ(screen.ToString(), "build 1");
+
+  Render(screen, memo(key, 1, build));
+  EXPECT_EQ(built, 2);
+  EXPECT_EQ(screen.ToString(), "build 2");
+}
+
+TEST(MemoTest, ReuseLayout) {
+  MemoKey key;
+  int layouts = 0;
+  auto build = [&] {
+    return vbox({
+        std::make_shared<Counter>(&layouts),
+        std::make_shared<Counter>(&layouts),
+    });
+  };
+  auto document = [&] { return memo(key, 0, build) | border; };
+
+  Screen screen(5, 4);
+  Render(screen, document());
+  const int first_layouts = layouts;
+  EXPECT_GT(first_layouts, 0);
+
+  Render(screen, document());
+  EXPECT_EQ(layouts, first_layouts);
+
+  // A new box.
+  Screen wide(7, 4);
+  Render(wide, document());
+  EXPECT_GT(layouts, first_layouts);
+}
+
+TEST(MemoTest, Resize) {
+  const std::string content = "aaa bbb ccc ddd eee";
+  MemoKey key;
+  auto document = [&] {
+    return vbox({
+        text("title"),
+        memo(key, 0, [&] { return paragraph(content); }),
+        text("end"),
+    });
+  };
+  auto expected = vbox({
+      text("title"),
+      paragraph(content),
+      text("end"),
+  });
+
+  for (int width : {20, 8, 4, 8, 12, 12, 20}) {
+    Screen screen(width, 8);
+    Render(screen, document());
+    Screen reference(width, 8);
+    Render(reference, expected);
+    EXPECT_EQ(screen.ToString(), reference.ToString()) << width;
+  }
+}
+
+TEST(MemoTest, Focus) {
+  MemoKey key;
+  auto build = [] {
+    Elements rows;
+    for (int i = 0; i < 100; ++i) {
+      auto row = text(std::to_string(i));
+      rows.push_back(i == 50 ? row | focus : row);
+    }
+    return vbox(std::move(rows));
+  };
+
+  for (int i = 0; i < 2; ++i) {
+    Screen screen(2, 3);
+    Render(screen, memo(key, 0, build) | frame);
+    EXPECT_EQ(screen.ToString(),
+              "49\r\n"
+              "50\r\n"
+              "51");
+  }
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -1,7 +1,9 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
+#include <algorithm>             // for copy_n, max, min
 #include <ftxui/screen/box.hpp>  // for Box
+#include <functional>            // for function
 #include <utility>               // for move
 
 #include "ftxui/dom/node.hpp"
@@ -9,6 +11,18 @@
 
 namespace ftxui {
 
+namespace {
+
+// A screen holding a band of lines of a taller element. The element is drawn
+// at its own coordinates: the rows are offset by the first line of the band.
+class BandScreen : public Screen {
+ public:
+  using Screen::Screen;
+  void SetOriginY(int y) { origin_y_ = y; }
+};
+
+}  // namespace
+
 Node::Node() = default;
 Node::Node(Elements children) : children_(std::move(children)) {}
 Node::~Node() = default;
@@ -25,6 +39,7 @@ void Node::ComputeRequirement() {
 /// @ingroup dom
 void Node::SetBox(Box box) {
   box_ = box;
+  box_set_ = true;
 }
 
 /// @brief Display an element on a ftxui::Screen.
@@ -42,6 +57,34 @@ void Node::Check(Status* status) {
   status->need_iteration |= (status->iteration == 0);
 }
 
+void Node::RenderChild(Screen& screen, Node* child) {
+  // An empty box is located at its minimum. Nodes overriding SetBox() without
+  // calling Node::SetBox() may draw anywhere.
+  const Box& box = child->box_;
+  const Box& stencil = screen.stencil;
+  const bool outside = box.x_min > stencil.x_max || box.y_min > stencil.y_max ||
+                       std::max(box.x_min, box.x_max) < stencil.x_min ||
+                       std::max(box.y_min, box.y_max) < stencil.y_min;
+  if (child->box_set_ && outside) {
+    screen.culled++;
+    return;
+  }
+  child->Render(screen);
+}
+
+void Node::Layout(Node* node, Box box) {
+  Status status;
+  node->Check(&status);
+  const int max_iterations = 20;
+  while (status.need_iteration && status.iteration < max_iterations) {
+    node->ComputeRequirement();
+    node->SetBox(box);
+    status.need_iteration = false;
+    status.iteration++;
+    node->Check(&status);
+  }
+}
+
 /// @brief Display an element on a ftxui::Screen.
 /// @ingroup dom
 void Render(Screen& screen, const Element& element) {
@@ -75,10 +118,99 @@ void Render(Screen& screen, Node* node) {
 
   // Step 3: Draw the element.
   screen.stencil = box;
+  screen.culled = 0;
   node->Render(screen);
 
   // Step 4: Apply shaders
   screen.ApplyShader();
 }
 
+/// @brief Display an element taller than the screen, a band of screen.dimy()
+/// lines at a time. The memory used is bounded by the size of the band, instead
+/// of the height of the element.
+///
+/// The layout is computed once, for the width of the screen and the height
+/// required by the element. Then, for each band, the element is drawn into
+/// |screen| and |on_band| is called. The element isn't moved: the band is
+/// drawn into a screen whose rows start on its first line, and the containers
+/// skip the children outside of it. The last band is resized to the remaining
+/// lines. The bands are identical to the lines of a screen as tall as the
+/// element, including the box characters merged in between two bands.
+///
+/// ### Example
+///
+/// ```cpp
+/// Screen band(80, 256);
+/// RenderBands(band, document, [](Screen& band) {
+///   std::cout << band.ToString() << '\n';
+/// });
+/// ```
+/// @ingroup dom
+void RenderBands(Screen& screen,
+                 const Element& element,
+                 const std::function<void(Screen&)>& on_band) {
+  Node* node = element.get();
+  const int dimx = screen.dimx();
+  const int band_height = screen.dimy();
+  if (dimx <= 0 || band_height <= 0) {
+    return;
+  }
+
+  // Step 1 and 2: Compute the layout, giving the element the height it needs.
+  Box box;
+  box.x_min = 0;
+  box.y_min = 0;
+  box.x_max = dimx - 1;
+  box.y_max = 0;
+
+  Node::Status status;
+  node->Check(&status);
+  const int max_iterations = 20;
+  while (status.need_iteration && status.iteration < max_iterations) {
+    node->ComputeRequirement();
+    box.y_max = node->requirement().min_y - 1;
+    node->SetBox(box);
+    status.need_iteration = false;
+    status.iteration++;
+    node->Check(&status);
+  }
+  const int height = box.y_max + 1;
+
+  // The band is drawn with an additional line above and below, so that the box
+  // characters are merged with the neighboring bands.
+  BandScreen work(dimx, band_height + 2);
+
+  for (int band_y = 0; band_y < height; band_y += band_height) {
+    const int lines = std::min(band_height, height - band_y);
+
+    // Step 3: Draw the lines of the band, starting on the second line of
+    // |work|.
+    work.Clear();
+    work.SetOriginY(band_y - 1);
+    work.stencil = {0, dimx - 1, band_y - 1, band_y + lines};
+    node->Render(work);
+
+    // Step 4: Apply shaders
+    work.ApplyShader();
+
+    if (screen.dimy() == lines) {
+      screen.Clear();
+    } else {
+      screen.Resize(dimx, lines);
+    }
+    for (int y = 0; y < lines; ++y) {
+      Pixel* row = screen.Row(y);
+      std::copy_n(work.Row(band_y + y), dimx, row);
+      for (int x = 0; x < dimx; ++x) {
+        if (row[x].hyperlink != 0) {
+          row[x].hyperlink =
+              screen.RegisterHyperlink(work.Hyperlink(row[x].hyperlink));
+        }
+      }
+    }
+    screen.stencil = {0, dimx - 1, 0, lines - 1};
+    on_band(screen);
+  }
+}
+
 }  // namespace ftxui
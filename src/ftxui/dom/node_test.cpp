@@ -0,0 +1,155 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <memory>  // for make_shared
+#include <string>  // for string, to_string
+#include <vector>  // for vector
+
+#include "ftxui/dom/elements.hpp"  // for text, vbox, border, hyperlink, frame
+#include "ftxui/dom/node.hpp"      // for Render, RenderBands
+#include "ftxui/dom/table.hpp"     // for Table
+#include "ftxui/screen/box.hpp"     // for Box
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(NodeTest, RenderBands) {
+  std::vector<std::vector<std::string>> rows;
+  for (int i = 0; i < 10; ++i) {
+    rows.push_back({std::to_string(i), "item " + std::to_string(i)});
+  }
+  auto table = Table(rows);
+  table.SelectAll().Border(LIGHT);
+  table.SelectAll().SeparatorVertical(LIGHT);
+  table.SelectAll().SeparatorHorizontal(LIGHT);
+  auto document = vbox({
+      table.Render(),
+      text("link") | hyperlink("https://a.com"),
+  });
+
+  Screen full(12, 22);
+  Render(full, document);
+
+  // The bands are the lines of the full screen, merged box characters
+  // included.
+  for (int band_height : {1, 2, 5, 22, 30}) {
+    Screen band(12, band_height);
+    int y = 0;
+    RenderBands(band, document, [&](Screen& printed) {
+      for (int dy = 0; dy < printed.dimy(); ++dy) {
+        for (int x = 0; x < printed.dimx(); ++x) {
+          EXPECT_EQ(printed.at(x, dy), full.at(x, y + dy));
+          EXPECT_EQ(printed.Hyperlink(printed.PixelAt(x, dy).hyperlink),
+                    full.Hyperlink(full.PixelAt(x, y + dy).hyperlink));
+        }
+      }
+      y += printed.dimy();
+    });
+    EXPECT_EQ(y, 22);
+  }
+}
+
+// Count the calls to SetBox() and Render().
+class Counter : public Node {
+ public:
+  Counter(int* set_box, int* render) : set_box_(set_box), render_(render) {}
+  void ComputeRequirement() override {
+    requirement_.min_x = 1;
+    requirement_.min_y = 1;
+  }
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    (*set_box_)++;
+  }
+  void Render(Screen& /*screen*/) override { (*render_)++; }
+
+ private:
+  int* set_box_;
+  int* render_;
+};
+
+TEST(NodeTest, RenderBandsLayoutOnce) {
+  int set_box = 0;
+  int render = 0;
+  Elements rows;
+  for (int i = 0; i < 1000; ++i) {
+    rows.push_back(std::make_shared<Counter>(&set_box, &render));
+  }
+  auto document = vbox(std::move(rows)) | border;
+
+  Screen band(3, 10);
+  int bands = 0;
+  RenderBands(band, document, [&](Screen&) { bands++; });
+  EXPECT_EQ(bands, 101);
+
+  // The layout is computed once, not for every band.
+  EXPECT_EQ(set_box, 1000);
+
+  // Every band draws its lines, plus the one above and below.
+  EXPECT_EQ(render, 1000 + 2 * 100);
+}
+
+TEST(NodeTest, Culling) {
+  std::vector<Box> boxes(1000);
+  Elements rows;
+  for (int i = 0; i < 1000; ++i) {
+    auto row = text(std::to_string(i)) | reflect(boxes[i]);
+    rows.push_back(i == 500 ? row | focus : row);
+  }
+  auto document = vbox(std::move(rows)) | frame | border;
+
+  Screen screen(5, 5);
+  Render(screen, document);
+  EXPECT_EQ(screen.ToString(),
+            "╭───╮\r\n"
+            "│499│\r\n"
+            "│500│\r\n"
+            "│501│\r\n"
+            "╰───╯");
+
+  // Only the visible rows are drawn.
+  EXPECT_EQ(screen.culled, 997);
+
+  // The rows skipped have an empty box.
+  EXPECT_EQ(boxes[500], (Box{1, 3, 2, 2}));
+  EXPECT_TRUE(boxes[499].Contain(1, 1));
+  EXPECT_FALSE(boxes[498].Contain(1, 0));
+  EXPECT_FALSE(boxes[502].Contain(1, 4));
+}
+
+// A node overriding SetBox() without calling Node::SetBox().
+class CustomSetBox : public Node {
+ public:
+  void ComputeRequirement() override {
+    requirement_.min_x = 1;
+    requirement_.min_y = 1;
+  }
+  void SetBox(Box box) override { custom_box_ = box; }
+  void Render(Screen& screen) override {
+    screen.PixelAt(custom_box_.x_min, custom_box_.y_min).character = "X";
+  }
+
+ private:
+  Box custom_box_;
+};
+
+TEST(NodeTest, CullingCustomSetBox) {
+  // The box of the node is unknown. It is drawn, even though its default box
+  // is outside of the stencil of the frame.
+  auto document = hbox({
+      text("ab"),
+      vbox({text("0"), std::make_shared<CustomSetBox>()}) | frame,
+  });
+
+  Screen screen(3, 2);
+  Render(screen, document);
+  EXPECT_EQ(screen.ToString(),
+            "ab0\r\n"
+            "  X");
+  EXPECT_EQ(screen.culled, 0);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -1,25 +1,299 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <sstream>  // for basic_istream, stringstream
-#include <string>   // for string, allocator, getline
-#include <utility>  // for move
+#include <algorithm>    // for lower_bound, max, min
+#include <array>        // for array
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t
+#include <memory>       // for shared_ptr
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <vector>       // for vector
 
-#include "ftxui/dom/elements.hpp"  // for flexbox, Element, text, Elements, operator|, xflex, paragraph, paragraphAlignCenter, paragraphAlignJustify, paragraphAlignLeft, paragraphAlignRight
-#include "ftxui/dom/flexbox_config.hpp"  // for FlexboxConfig, FlexboxConfig::JustifyContent, FlexboxConfig::JustifyContent::Center, FlexboxConfig::JustifyContent::FlexEnd, FlexboxConfig::JustifyContent::SpaceBetween
+#include "ftxui/dom/box_helper.hpp"  // for Element, Compute
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
+#include "ftxui/dom/elements.hpp"  // for Element, paragraph, paragraphAlignCenter, paragraphAlignJustify, paragraphAlignLeft, paragraphAlignRight
+#include "ftxui/dom/flexbox_config.hpp"  // for FlexboxConfig, FlexboxConfig::JustifyContent, FlexboxConfig::JustifyContent::Center, FlexboxConfig::JustifyContent::FlexEnd, FlexboxConfig::JustifyContent::FlexStart, FlexboxConfig::JustifyContent::SpaceBetween
+#include "ftxui/dom/node.hpp"         // for Node, Node::Status
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Pixel, Screen
+#include "ftxui/screen/string.hpp"    // for Utf8Glyphs, GlyphView
 
 namespace ftxui {
 
 namespace {
-Elements Split(const std::string& the_text) {
-  Elements output;
-  std::stringstream ss(the_text);
-  std::string word;
-  while (std::getline(ss, word, ' ')) {
-    output.push_back(text(word));
+
+using JustifyContent = FlexboxConfig::JustifyContent;
+
+// Draw the words one after the other, separated by one space, and wrap them on
+// the next line when full. This is the layout of a flexbox of text(word)
+// elements, but the text is stored once, and the lines are computed once per
+// width.
+class Paragraph : public Node {
+ public:
+  Paragraph(const std::string& text, JustifyContent justify_content)
+      : text_(text), justify_content_(justify_content) {
+    requirement_.flex_grow_x = 1;
+
+    // Split on every space, like std::getline.
+    size_t start = 0;
+    while (start < text_.size()) {
+      size_t end = text_.find(' ', start);
+      if (end == std::string::npos) {
+        end = text_.size();
+      }
+      Word word;
+      word.start = uint32_t(start);
+      word.size = uint32_t(end - start);
+      for (const GlyphView& glyph : Utf8Glyphs(View(word))) {
+        word.width += glyph.width;
+      }
+      words_.push_back(word);
+      start = end + 1;
+    }
+
+    // A justified paragraph ends with an empty flexible word, taking the
+    // remaining space of the last line. This aligns it on the left.
+    if (justify_content_ == JustifyContent::SpaceBetween) {
+      Word word;
+      word.flexible = true;
+      words_.push_back(word);
+    }
   }
-  return output;
-}
+
+  void ComputeRequirement() override {
+    const Lines& lines = Wrap(asked_);
+    requirement_.min_x = lines.min_x;
+    requirement_.min_y = lines.height;
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    const int asked_previous = asked_;
+    asked_ = std::min(asked_, box.x_max - box.x_min + 1);
+    need_iteration_ = (asked_ != asked_previous);
+  }
+
+  void Check(Status* status) override {
+    if (status->iteration == 0) {
+      asked_ = 6000;  // NOLINT
+      need_iteration_ = true;
+    }
+    status->need_iteration |= need_iteration_;
+  }
+
+  void Render(Screen& screen) override {
+    const int size_x = box_.x_max - box_.x_min + 1;
+    const Lines& lines = Wrap(size_x);
+    const Box& stencil = screen.stencil;
+
+    // Only the visible lines are placed and drawn.
+    const size_t first =
+        std::lower_bound(lines.ys.begin(), lines.ys.end(),
+                         stencil.y_min - box_.y_min) -
+        lines.ys.begin();
+    for (size_t line = first; line < lines.ys.size(); ++line) {
+      const int y = box_.y_min + lines.ys[line];
+      if (y > box_.y_max || y > stencil.y_max) {
+        break;
+      }
+      if (lines.heights[line] == 0) {
+        continue;
+      }
+
+      Place(lines, line, size_x, /*compute_requirement=*/false);
+      const size_t begin = lines.starts[line];
+      for (size_t i = 0; i < xs_.size(); ++i) {
+        const int x_min = box_.x_min + xs_[i];
+        const int x_max = std::min(x_min + dims_[i] - 1, box_.x_max);
+        DrawWord(screen, words_[begin + i], x_min, x_max, y);
+      }
+    }
+  }
+
+ private:
+  struct Word {
+    uint32_t start = 0;
+    uint32_t size = 0;
+    int width = 0;
+    bool flexible = false;
+  };
+
+  // The words wrapped at a given width. |starts| holds the index of the first
+  // word of every line, followed by the number of words.
+  struct Lines {
+    bool valid = false;
+    int width = 0;
+    std::vector<size_t> starts;
+    std::vector<int> ys;
+    std::vector<int> heights;
+    int min_x = 0;
+    int height = 0;
+  };
+
+  std::string_view View(const Word& word) const {
+    return std::string_view(text_).substr(word.start, word.size);
+  }
+
+  const Lines& Wrap(int width) {
+    for (const Lines& lines : cache_) {
+      if (lines.valid && lines.width == width) {
+        return lines;
+      }
+    }
+    Lines& lines = cache_[cache_next_];
+    cache_next_ = (cache_next_ + 1) % cache_.size();
+    lines.valid = true;
+    lines.width = width;
+    lines.starts.clear();
+
+    // Start a new line when the next word doesn't fit.
+    int x = 0;
+    size_t begin = 0;
+    for (size_t i = 0; i < words_.size(); ++i) {
+      if (x + words_[i].width > width) {
+        x = 0;
+        if (i != begin) {
+          lines.starts.push_back(begin);
+          begin = i;
+        }
+      }
+      x += words_[i].width + 1;
+    }
+    if (!words_.empty()) {
+      lines.starts.push_back(begin);
+    }
+    const size_t count = lines.starts.size();
+    lines.starts.push_back(words_.size());
+
+    // The lines are one cell high. The flexbox limits the total to 10000.
+    elements_.assign(count, {});
+    for (auto& element : elements_) {
+      element.min_size = 1;
+    }
+    box_helper::Compute(&elements_, 10000);  // NOLINT
+    lines.ys.resize(count);
+    lines.heights.resize(count);
+    int y = 0;
+    for (size_t line = 0; line < count; ++line) {
+      lines.ys[line] = y;
+      lines.heights[line] = std::min(elements_[line].size, 1);
+      y += elements_[line].size;
+    }
+
+    // The requirement is the union of the words, placed on the left.
+    lines.min_x = 0;
+    lines.height = 0;
+    for (size_t line = 0; line < count; ++line) {
+      Place(lines, line, width, /*compute_requirement=*/true);
+      for (size_t i = 0; i < xs_.size(); ++i) {
+        lines.min_x = std::max(lines.min_x, xs_[i] + dims_[i]);
+      }
+      lines.height =
+          std::max(lines.height, lines.ys[line] + lines.heights[line]);
+    }
+    return lines;
+  }
+
+  // Compute the position |xs_| and the width |dims_| of the words of |line|.
+  void Place(const Lines& lines,
+             size_t line,
+             int size_x,
+             bool compute_requirement) {
+    const size_t begin = lines.starts[line];
+    const size_t end = lines.starts[line + 1];
+    elements_.clear();
+    for (size_t i = begin; i < end; ++i) {
+      box_helper::Element element;
+      element.min_size = words_[i].width;
+      if (words_[i].flexible && !compute_requirement) {
+        element.flex_grow = 1;
+        element.flex_shrink = 1;
+      }
+      elements_.push_back(element);
+    }
+    box_helper::Compute(&elements_, size_x - (int(end - begin) - 1));
+
+    xs_.resize(elements_.size());
+    dims_.resize(elements_.size());
+    int x = 0;
+    for (size_t i = 0; i < elements_.size(); ++i) {
+      xs_[i] = x;
+      dims_[i] = elements_[i].size;
+      x += elements_[i].size + 1;
+    }
+
+    if (compute_requirement || xs_.empty()) {
+      return;
+    }
+
+    // Distribute the remaining space.
+    int remaining_space = size_x - xs_.back() - dims_.back();
+    switch (justify_content_) {
+      case JustifyContent::FlexEnd: {
+        for (int& xi : xs_) {
+          xi += remaining_space;
+        }
+        break;
+      }
+
+      case JustifyContent::Center: {
+        for (int& xi : xs_) {
+          xi += remaining_space / 2;
+        }
+        break;
+      }
+
+      case JustifyContent::SpaceBetween: {
+        for (int i = int(xs_.size()) - 1; i >= 1; --i) {
+          xs_[i] += remaining_space;
+          remaining_space = remaining_space * (i - 1) / i;
+        }
+        break;
+      }
+
+      default:
+        break;
+    }
+  }
+
+  void DrawWord(Screen& screen, const Word& word, int x, int x_max, int y) {
+    const Box& stencil = screen.stencil;
+    if (y < stencil.y_min || y > stencil.y_max) {
+      return;
+    }
+    x_max = std::min(x_max, stencil.x_max);
+    Pixel* row = screen.Row(y);
+    for (const GlyphView& glyph : Utf8Glyphs(View(word))) {
+      if (x > x_max) {
+        return;
+      }
+      if (glyph.text == "\n") {
+        continue;
+      }
+      if (x >= stencil.x_min) {
+        row[x].character = glyph.text;
+      }
+      ++x;
+    }
+  }
+
+  const std::string text_;
+  const JustifyContent justify_content_;
+  std::vector<Word> words_;
+
+  int asked_ = 6000;  // NOLINT
+  bool need_iteration_ = true;
+  std::array<Lines, 2> cache_;
+  size_t cache_next_ = 0;
+
+  // Reused while placing the words of a line.
+  std::vector<box_helper::Element> elements_;
+  std::vector<int> xs_;
+  std::vector<int> dims_;
+};
+
 }  // namespace
 
 /// @brief Return an element drawing the paragraph on multiple lines.
@@ -34,8 +308,7 @@ Element paragraph(const std::string& the_text) {
 /// @ingroup dom
 /// @see flexbox.
 Element paragraphAlignLeft(const std::string& the_text) {
-  static const auto config = FlexboxConfig().SetGap(1, 0);
-  return flexbox(Split(the_text), config);
+  return MakeElement<Paragraph>(the_text, JustifyContent::FlexStart);
 }
 
 /// @brief Return an element drawing the paragraph on multiple lines, aligned on
@@ -43,9 +316,7 @@ Element paragraphAlignLeft(const std::string& the_text) {
 /// @ingroup dom
 /// @see flexbox.
 Element paragraphAlignRight(const std::string& the_text) {
-  static const auto config =
-      FlexboxConfig().SetGap(1, 0).Set(FlexboxConfig::JustifyContent::FlexEnd);
-  return flexbox(Split(the_text), config);
+  return MakeElement<Paragraph>(the_text, JustifyContent::FlexEnd);
 }
 
 /// @brief Return an element drawing the paragraph on multiple lines, aligned on
@@ -53,9 +324,7 @@ Element paragraphAlignRight(const std::string& the_text) {
 /// @ingroup dom
 /// @see flexbox.
 Element paragraphAlignCenter(const std::string& the_text) {
-  static const auto config =
-      FlexboxConfig().SetGap(1, 0).Set(FlexboxConfig::JustifyContent::Center);
-  return flexbox(Split(the_text), config);
+  return MakeElement<Paragraph>(the_text, JustifyContent::Center);
 }
 
 /// @brief Return an element drawing the paragraph on multiple lines, aligned
@@ -64,11 +333,7 @@ Element paragraphAlignCenter(const std::string& the_text) {
 /// @ingroup dom
 /// @see flexbox.
 Element paragraphAlignJustify(const std::string& the_text) {
-  static const auto config = FlexboxConfig().SetGap(1, 0).Set(
-      FlexboxConfig::JustifyContent::SpaceBetween);
-  Elements words = Split(the_text);
-  words.push_back(text("") | xflex);
-  return flexbox(std::move(words), config);
+  return MakeElement<Paragraph>(the_text, JustifyContent::SpaceBetween);
 }
 
 }  // namespace ftxui
@@ -0,0 +1,178 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <functional>  // for function
+#include <iterator>    // for size
+#include <random>      // for mt19937, uniform_int_distribution
+#include <sstream>     // for stringstream
+#include <string>      // for allocator, string, getline
+#include <utility>     // for move, pair
+#include <vector>      // for vector
+
+#include "ftxui/dom/elements.hpp"  // for paragraph, paragraphAlignRight, ...
+#include "ftxui/dom/flexbox_config.hpp"  // for FlexboxConfig
+#include "ftxui/dom/node.hpp"            // for Render
+#include "ftxui/screen/screen.hpp"       // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+const std::string kText = "The quick brown fox jumps over the lazy dog";
+
+// The paragraphs used to be built as a flexbox of words. This is kept as a
+// reference for the dedicated node.
+Elements Split(const std::string& the_text) {
+  Elements output;
+  std::stringstream ss(the_text);
+  std::string word;
+  while (std::getline(ss, word, ' ')) {
+    output.push_back(text(word));
+  }
+  return output;
+}
+
+Element ReferenceParagraph(const std::string& the_text,
+                           FlexboxConfig::JustifyContent justify) {
+  const auto config = FlexboxConfig().SetGap(1, 0).Set(justify);
+  Elements words = Split(the_text);
+  if (justify == FlexboxConfig::JustifyContent::SpaceBetween) {
+    words.push_back(text("") | xflex);
+  }
+  return flexbox(std::move(words), config);
+}
+
+// Random words, with CJK, control characters, repeated spaces, and words
+// longer than the screen.
+std::string RandomText(std::mt19937& random) {
+  const char* pieces[] = {
+      " ",  "  ", "   ", "a",  "bb", "ccc",      "dddd", "eeeee",
+      "测", "试", "\1",  "\t", "\n", "a\u20d2", "🪐",
+      "wwwwwwwwwwwwwwwwwwwwwwwwwwwwww",  // Longer than the screen.
+  };
+  std::uniform_int_distribution<int> piece(0, std::size(pieces) - 1);
+  std::uniform_int_distribution<int> length(0, 30);
+  std::string out;
+  const int count = length(random);
+  for (int i = 0; i < count; ++i) {
+    out += pieces[piece(random)];
+  }
+  return out;
+}
+}  // namespace
+
+TEST(ParagraphTest, Left) {
+  Screen screen(12, 5);
+  Render(screen, paragraphAlignLeft(kText));
+  EXPECT_EQ(screen.ToString(),
+            "The quick   \r\n"
+            "brown fox   \r\n"
+            "jumps over  \r\n"
+            "the lazy dog\r\n"
+            "            ");
+}
+
+TEST(ParagraphTest, Right) {
+  Screen screen(12, 5);
+  Render(screen, paragraphAlignRight(kText));
+  EXPECT_EQ(screen.ToString(),
+            "   The quick\r\n"
+            "   brown fox\r\n"
+            "  jumps over\r\n"
+            "the lazy dog\r\n"
+            "            ");
+}
+
+TEST(ParagraphTest, Center) {
+  Screen screen(12, 5);
+  Render(screen, paragraphAlignCenter(kText));
+  EXPECT_EQ(screen.ToString(),
+            " The quick  \r\n"
+            " brown fox  \r\n"
+            " jumps over \r\n"
+            "the lazy dog\r\n"
+            "            ");
+}
+
+TEST(ParagraphTest, Justify) {
+  Screen screen(12, 5);
+  Render(screen, paragraphAlignJustify(kText));
+  EXPECT_EQ(screen.ToString(),
+            "The    quick\r\n"
+            "brown    fox\r\n"
+            "jumps   over\r\n"
+            "the lazy dog\r\n"
+            "            ");
+}
+
+TEST(ParagraphTest, Empty) {
+  Screen screen(6, 3);
+  Render(screen, paragraph("") | border);
+  EXPECT_EQ(screen.ToString(),
+            "╭────╮\r\n"
+            "│    │\r\n"
+            "╰────╯");
+}
+
+TEST(ParagraphTest, Relayout) {
+  auto element = paragraph("aaa bbb ccc ddd") | border;
+  Screen narrow(9, 5);
+  Render(narrow, element);
+  const std::string narrow_output =
+      "╭───────╮\r\n"
+      "│aaa bbb│\r\n"
+      "│ccc ddd│\r\n"
+      "│       │\r\n"
+      "╰───────╯";
+  EXPECT_EQ(narrow.ToString(), narrow_output);
+
+  Screen wide(13, 4);
+  Render(wide, element);
+  EXPECT_EQ(wide.ToString(),
+            "╭───────────╮\r\n"
+            "│aaa bbb ccc│\r\n"
+            "│ddd        │\r\n"
+            "╰───────────╯");
+
+  Render(narrow, element);
+  EXPECT_EQ(narrow.ToString(), narrow_output);
+}
+
+TEST(ParagraphTest, SameAsFlexbox) {
+  using J = FlexboxConfig::JustifyContent;
+  const std::vector<std::pair<std::function<Element(const std::string&)>, J>>
+      variants = {
+          {paragraphAlignLeft, J::FlexStart},
+          {paragraphAlignRight, J::FlexEnd},
+          {paragraphAlignCenter, J::Center},
+          {paragraphAlignJustify, J::SpaceBetween},
+      };
+  const std::vector<Decorator> containers = {
+      nothing,
+      border,
+      [](Element e) { return vbox({std::move(e), text("end")}) | yframe; },
+      [](Element e) { return hbox({text("<"), std::move(e) | border}); },
+  };
+
+  std::mt19937 random(20);  // NOLINT
+  std::uniform_int_distribution<int> size(1, 24);
+  for (int i = 0; i < 500; ++i) {
+    const std::string the_text = RandomText(random);
+    const int dimx = size(random);
+    const int dimy = size(random);
+    for (const auto& [build, justify] : variants) {
+      for (const auto& container : containers) {
+        Screen expected(dimx, dimy);
+        Render(expected, container(ReferenceParagraph(the_text, justify)));
+        Screen actual(dimx, dimy);
+        Render(actual, container(build(the_text)));
+        ASSERT_EQ(actual.ToString(), expected.ToString())
+            << "\"" << the_text << "\" " << dimx << "x" << dimy;
+      }
+    }
+  }
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -2,11 +2,12 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <algorithm>  // for max
-#include <memory>     // for make_shared, __shared_ptr_access
+#include <memory>     // for __shared_ptr_access
 #include <string>     // for string
 #include <utility>    // for move
 #include <vector>     // for __alloc_traits<>::value_type
 
+#include "ftxui/dom/element_arena.hpp"   // for MakeElement
 #include "ftxui/dom/elements.hpp"        // for Element, vscroll_indicator
 #include "ftxui/dom/node.hpp"            // for Node, Elements
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
@@ -30,7 +31,7 @@ Element vscroll_indicator(Element child) {
     }
 
     void SetBox(Box box) override {
-      box_ = box;
+      Node::SetBox(box);
       box.x_max--;
       children_[0]->SetBox(box);
     }
@@ -69,7 +70,7 @@ Element vscroll_indicator(Element child) {
       }
     }
   };
-  return std::make_shared<Impl>(std::move(child));
+  return MakeElement<Impl>(std::move(child));
 }
 
 }  // namespace ftxui
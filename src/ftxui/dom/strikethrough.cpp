@@ -1,9 +1,10 @@
 // Copyright 2023 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <memory>   // for make_shared
+#include <memory>   // for shared_ptr
 #include <utility>  // for move
 
+#include "ftxui/dom/element_arena.hpp"   // for MakeElement
 #include "ftxui/dom/elements.hpp"        // for Element, strikethrough
 #include "ftxui/dom/node.hpp"            // for Node
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
@@ -20,16 +21,18 @@ Element strikethrough(Element child) {
     using NodeDecorator::NodeDecorator;
 
     void Render(Screen& screen) override {
-      for (int y = box_.y_min; y <= box_.y_max; ++y) {
-        for (int x = box_.x_min; x <= box_.x_max; ++x) {
-          screen.PixelAt(x, y).strikethrough = true;
+      const Box box = Box::Intersection(box_, screen.stencil);
+      for (int y = box.y_min; y <= box.y_max; ++y) {
+        Pixel* row = screen.Row(y);
+        for (int x = box.x_min; x <= box.x_max; ++x) {
+          row[x].strikethrough = true;
         }
       }
       Node::Render(screen);
     }
   };
 
-  return std::make_shared<Impl>(std::move(child));
+  return MakeElement<Impl>(std::move(child));
 }
 
 }  // namespace ftxui
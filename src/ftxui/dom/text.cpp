@@ -1,31 +1,115 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for min
-#include <memory>     // for make_shared
-#include <string>     // for string, wstring
-#include <utility>    // for move
-#include <vector>     // for vector
+#include <algorithm>    // for min
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t
+#include <functional>   // for less_equal
+#include <memory>       // for shared_ptr
+#include <string>       // for string, wstring
+#include <string_view>  // for string_view
+#include <utility>      // for move
+#include <vector>       // for vector
 
 #include "ftxui/dom/deprecated.hpp"   // for text, vtext
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
 #include "ftxui/dom/elements.hpp"     // for Element, text, vtext
 #include "ftxui/dom/node.hpp"         // for Node
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/screen.hpp"    // for Pixel, Screen
-#include "ftxui/screen/string.hpp"  // for string_width, Utf8ToGlyphs, to_string
+#include "ftxui/screen/string.hpp"    // for string_width, Utf8Glyphs, GlyphView, to_string
 
 namespace ftxui {
 
 namespace {
 using ftxui::Screen;
 
+// A text, segmented into glyphs the first time it is measured. The layout and
+// every render of the node reuse it.
+class MeasuredText {
+ public:
+  explicit MeasuredText(std::string text) : text_(std::move(text)) {}
+
+  // The number of cells taken by the text.
+  int width() {
+    Measure();
+    return width_;
+  }
+
+  size_t size() {
+    Measure();
+    return simple_ ? text_.size() : glyphs_.size();
+  }
+
+  GlyphView operator[](size_t i) const {
+    if (simple_) {
+      return {std::string_view(text_.data() + i, 1), 1};
+    }
+    const Glyph& glyph = glyphs_[i];
+    if (glyph.composed) {
+      return {composed_[glyph.start], int(glyph.width)};
+    }
+    return {std::string_view(text_.data() + glyph.start, glyph.size),
+            int(glyph.width)};
+  }
+
+ private:
+  struct Glyph {
+    uint32_t start;  // In |text_|, or the index in |composed_|.
+    uint32_t size : 29;
+    uint32_t width : 2;
+    uint32_t composed : 1;
+  };
+
+  void Measure() {
+    if (measured_) {
+      return;
+    }
+    measured_ = true;
+
+    // Most texts are made of characters taking one byte and one cell. Nothing
+    // is stored for them. Every other glyph takes more bytes than cells.
+    width_ = string_width(text_);
+    if (size_t(width_) == text_.size()) {
+      return;
+    }
+
+    // There is one glyph per cell.
+    simple_ = false;
+    glyphs_.reserve(size_t(width_));
+    const std::less_equal<const char*> less_equal;
+    const char* const text_end = text_.data() + text_.size();
+    for (const GlyphView& glyph : Utf8Glyphs(text_)) {
+      const uint32_t size = uint32_t(glyph.text.size());
+      const uint32_t width = uint32_t(glyph.width);
+      const char* const data = glyph.text.data();
+      if (size == 0 ||
+          (less_equal(text_.data(), data) && less_equal(data, text_end))) {
+        glyphs_.push_back({uint32_t(data - text_.data()), size, width, 0u});
+        continue;
+      }
+
+      // Rarely, the glyph is not a view into the text. See Utf8Glyphs().
+      glyphs_.push_back({uint32_t(composed_.size()), size, width, 1u});
+      composed_.emplace_back(glyph.text);
+    }
+  }
+
+  std::string text_;
+  std::vector<Glyph> glyphs_;
+  std::vector<std::string> composed_;
+  int width_ = 0;
+  bool measured_ = false;
+  bool simple_ = true;  // Every byte is a glyph taking one cell.
+};
+
 class Text : public Node {
  public:
   explicit Text(std::string text) : text_(std::move(text)) {}
 
   void ComputeRequirement() override {
-    requirement_.min_x = string_width(text_);
+    requirement_.min_x = text_.width();
     requirement_.min_y = 1;
   }
 
@@ -35,50 +119,59 @@ class Text : public Node {
     if (y > box_.y_max) {
       return;
     }
-    for (const auto& cell : Utf8ToGlyphs(text_)) {
-      if (x > box_.x_max) {
+    const Box& stencil = screen.stencil;
+    if (y < stencil.y_min || y > stencil.y_max) {
+      return;
+    }
+    const int x_max = std::min(box_.x_max, stencil.x_max);
+    Pixel* row = screen.Row(y);
+    const size_t size = text_.size();
+    for (size_t g = 0; g < size; ++g) {
+      if (x > x_max) {
         return;
       }
-      if (cell == "\n") {
+      const GlyphView glyph = text_[g];
+      if (glyph.text == "\n") {
         continue;
       }
-      screen.PixelAt(x, y).character = cell;
+      if (x >= stencil.x_min) {
+        row[x].character = glyph.text;
+      }
       ++x;
     }
   }
 
  private:
-  std::string text_;
+  MeasuredText text_;
 };
 
 class VText : public Node {
  public:
-  explicit VText(std::string text)
-      : text_(std::move(text)), width_{std::min(string_width(text_), 1)} {}
+  explicit VText(std::string text) : text_(std::move(text)) {}
 
   void ComputeRequirement() override {
-    requirement_.min_x = width_;
-    requirement_.min_y = string_width(text_);
+    requirement_.min_x = std::min(text_.width(), 1);
+    requirement_.min_y = text_.width();
   }
 
   void Render(Screen& screen) override {
     const int x = box_.x_min;
     int y = box_.y_min;
-    if (x + width_ - 1 > box_.x_max) {
+    if (x + std::min(text_.width(), 1) - 1 > box_.x_max) {
       return;
     }
-    for (const auto& it : Utf8ToGlyphs(text_)) {
+    const size_t size = text_.size();
+    for (size_t g = 0; g < size; ++g) {
       if (y > box_.y_max) {
         return;
       }
-      screen.PixelAt(x, y).character = it;
+      screen.PixelAt(x, y).character = text_[g].text;
       y += 1;
     }
   }
 
  private:
-  std::string text_;
-  int width_ = 1;
+  MeasuredText text_;
 };
 
 }  // namespace
@@ -99,7 +192,7 @@ class VText : public Node {
 /// Hello world!
 /// ```
 Element text(std::string text) {
-  return std::make_shared<Text>(std::move(text));
+  return MakeElement<Text>(std::move(text));
 }
 
 /// @brief Display a piece of unicode text.
@@ -118,7 +211,7 @@ Element text(std::string text) {
 /// Hello world!
 /// ```
 Element text(std::wstring text) {  // NOLINT
-  return std::make_shared<Text>(to_string(text));
+  return MakeElement<Text>(to_string(text));
 }
 
 /// @brief Display a piece of unicode text vertically.
@@ -148,7 +241,7 @@ Element text(std::wstring text) {  // NOLINT
 /// !
 /// ```
 Element vtext(std::string text) {
-  return std::make_shared<VText>(std::move(text));
+  return MakeElement<VText>(std::move(text));
 }
 
 /// @brief Display a piece unicode text vertically.
@@ -178,7 +271,7 @@ Element vtext(std::string text) {
 /// !
 /// ```
 Element vtext(std::wstring text) {  // NOLINT
-  return std::make_shared<VText>(to_string(text));
+  return MakeElement<VText>(to_string(text));
 }
 
 }  // namespace ftxui
@@ -121,5 +121,47 @@ TEST(TextTest, CombiningCharactersWithSpace) {
   EXPECT_EQ(t, screen.ToString());
 }
 
+TEST(TextTest, ControlCharacters) {
+  auto element = text("a\1b\n测c\1");
+  Screen screen(6, 1);
+  Render(screen, element);
+  EXPECT_EQ("ab测c ", screen.ToString());
+}
+
+// The combining characters following a fullwidth glyph go in its second cell.
+// The control characters in between are ignored.
+TEST(TextTest, CombiningCharactersCells) {
+  auto element = text("测̗a\1̗b");
+  Screen screen(4, 1);
+  Render(screen, element);
+  EXPECT_EQ(std::string(screen.at(0, 0)), "测");
+  EXPECT_EQ(std::string(screen.at(1, 0)), "̗");
+  EXPECT_EQ(std::string(screen.at(2, 0)), "a̗");
+  EXPECT_EQ(std::string(screen.at(3, 0)), "b");
+}
+
+TEST(TextTest, RenderTwice) {
+  auto element = text("a测b") | border;
+  Screen screen(6, 3);
+  Render(screen, element);
+  Render(screen, element);
+  EXPECT_EQ(
+      "╭────╮\r\n"
+      "│a测b│\r\n"
+      "╰────╯",
+      screen.ToString());
+}
+
+TEST(VTextTest, Measure) {
+  auto element = hbox({vtext("a测"), vtext("\1b")});
+  Screen screen(2, 3);
+  Render(screen, element);
+  EXPECT_EQ(
+      "ab\r\n"
+      "测\r\n"
+      " ",
+      screen.ToString());
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -1,17 +1,19 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for max
+#include <algorithm>  // for max, lower_bound, upper_bound
 #include <cstddef>    // for size_t
-#include <memory>  // for __shared_ptr_access, shared_ptr, make_shared, allocator_traits<>::value_type
+#include <memory>  // for __shared_ptr_access, shared_ptr, allocator_traits<>::value_type
 #include <utility>  // for move
 #include <vector>   // for vector, __alloc_traits<>::value_type
 
 #include "ftxui/dom/box_helper.hpp"   // for Element, Compute
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
 #include "ftxui/dom/elements.hpp"     // for Element, Elements, vbox
 #include "ftxui/dom/node.hpp"         // for Node, Elements
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
 
 namespace ftxui {
 
@@ -57,13 +59,41 @@ class VBox : public Node {
     box_helper::Compute(&elements, target_size);
 
     int y = box.y_min;
+    y_.resize(children_.size() + 1);
     for (size_t i = 0; i < children_.size(); ++i) {
+      y_[i] = y;
       box.y_min = y;
       box.y_max = y + elements[i].size - 1;
       children_[i]->SetBox(box);
       y = box.y_max + 1;
     }
+    y_.back() = y;
   }
+
+  // The children are sorted from top to bottom. The ones whose lines intersect
+  // the stencil are found by a binary search, and the others are skipped.
+  void Render(Screen& screen) override {
+    if (y_.size() != children_.size() + 1) {
+      Node::Render(screen);
+      return;
+    }
+    const Box& stencil = screen.stencil;
+    const int first = static_cast<int>(
+        std::lower_bound(y_.begin() + 1, y_.end(), stencil.y_min) -
+        (y_.begin() + 1));
+    const int last = static_cast<int>(
+        std::upper_bound(y_.begin(), y_.end() - 1, stencil.y_max) -
+        y_.begin());
+    const int size = static_cast<int>(children_.size());
+    screen.culled += size - std::max(0, last - first);
+    for (int i = first; i < last; ++i) {
+      RenderChild(screen, children_[i].get());
+    }
+  }
+
+ private:
+  // The first line of each child, and the line after the last one.
+  std::vector<int> y_;
 };
 }  // namespace
 
@@ -81,7 +111,7 @@ class VBox : public Node {
 /// });
 /// ```
 Element vbox(Elements children) {
-  return std::make_shared<VBox>(std::move(children));
+  return MakeElement<VBox>(std::move(children));
 }
 
 }  // namespace ftxui
@@ -0,0 +1,148 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>   // for max, min
+#include <cstdint>     // for int64_t
+#include <functional>  // for function
+#include <map>         // for map
+#include <memory>      // for __shared_ptr_access
+#include <utility>     // for move
+
+#include "ftxui/dom/element_arena.hpp"  // for MakeElement
+#include "ftxui/dom/elements.hpp"     // for Element, virtualList
+#include "ftxui/dom/node.hpp"         // for Node, Node::Status
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
+
+namespace ftxui {
+
+namespace {
+
+// The rows built above and below the visible ones.
+constexpr int kOverscan = 2;
+
+// The height of the list is bounded, so that the frame can't overflow when
+// computing its position.
+constexpr int64_t kMaxHeight = 1 << 30;
+
+class VirtualList : public Node {
+ public:
+  VirtualList(int count,
+              int row_height,
+              std::function<Element(int)> build,
+              int focused)
+      : count_(std::max(count, 0)),
+        row_height_(std::max(row_height, 1)),
+        build_(std::move(build)),
+        focused_(focused) {}
+
+  void ComputeRequirement() override {
+    requirement_ = Requirement();
+    requirement_.min_y = RowCount() * row_height_;
+    if (RowCount() == 0) {
+      return;
+    }
+
+    // Only one row is built: the focused one, or else the first one. Its width
+    // stands for the width of every row. The frame uses it to scroll.
+    const bool has_focus = focused_ >= 0 && focused_ < RowCount();
+    const int index = has_focus ? focused_ : 0;
+    Node* row = Row(index).get();
+    Node::Status status;
+    row->Check(&status);
+    row->ComputeRequirement();
+    requirement_.min_x = row->requirement().min_x;
+    requirement_.flex_grow_x = row->requirement().flex_grow_x;
+    requirement_.flex_shrink_x = row->requirement().flex_shrink_x;
+    if (!has_focus || row->requirement().selection == Requirement::NORMAL) {
+      return;
+    }
+    requirement_.selection = row->requirement().selection;
+    requirement_.selected_box = row->requirement().selected_box;
+    requirement_.selected_box.y_min += index * row_height_;
+    requirement_.selected_box.y_max += index * row_height_;
+  }
+
+  void Render(Screen& screen) override {
+    const Box visible = Box::Intersection(box_, screen.stencil);
+    if (RowCount() == 0 || visible.y_min > visible.y_max ||
+        visible.x_min > visible.x_max) {
+      return;
+    }
+
+    const int first = std::max(
+        0, (visible.y_min - box_.y_min) / row_height_ - kOverscan);
+    const int last = std::min(
+        RowCount() - 1, (visible.y_max - box_.y_min) / row_height_ + kOverscan);
+
+    // Forget the rows scrolled away.
+    rows_.erase(rows_.begin(), rows_.lower_bound(first));
+    rows_.erase(rows_.upper_bound(last), rows_.end());
+
+    for (int i = first; i <= last; ++i) {
+      Node* row = Row(i).get();
+      Box row_box = box_;
+      row_box.y_min = box_.y_min + i * row_height_;
+      row_box.y_max = row_box.y_min + row_height_ - 1;
+      Layout(row, row_box);
+      row->Render(screen);
+    }
+  }
+
+ private:
+  // The number of rows fitting in the bounded height.
+  int RowCount() const {
+    return int(std::min(int64_t(count_), kMaxHeight / row_height_));
+  }
+
+  const Element& Row(int index) {
+    auto it = rows_.find(index);
+    if (it == rows_.end()) {
+      it = rows_.emplace(index, build_(index)).first;
+    }
+    return it->second;
+  }
+
+  const int count_;
+  const int row_height_;
+  const std::function<Element(int)> build_;
+  const int focused_;
+  std::map<int, Element> rows_;
+};
+
+}  // namespace
+
+/// @brief A list of rows of the same height, displayed inside a `frame`. Only
+/// the rows intersecting the visible area, plus a few around them, are built
+/// and drawn. The time to display it doesn't depend on the number of rows.
+/// @param count The number of rows.
+/// @param row_height The height of every row.
+/// @param build Return the element of the row at a given index.
+/// @param focused The index of the row the frame scrolls to, or -1. It is
+///                built during the layout. The element returned by |build|
+///                must use `focus` or `select`, like in a `vbox`.
+///
+/// The width of the list is the width of the |focused| row, or of the first
+/// row when none is focused. The other rows are not measured: the wider ones
+/// are clipped.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// auto list = virtualList(1000000, 1, [&](int i) {
+///   auto row = text("Row " + std::to_string(i));
+///   return i == selected ? row | inverted | focus : row;
+/// }, selected);
+/// Element document = list | vscroll_indicator | frame | border;
+/// ```
+Element virtualList(int count,
+                    int row_height,
+                    std::function<Element(int)> build,
+                    int focused) {
+  return MakeElement<VirtualList>(count, row_height, std::move(build),
+                                       focused);
+}
+
+}  // namespace ftxui
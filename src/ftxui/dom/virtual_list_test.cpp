@@ -0,0 +1,129 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <string>  // for allocator, string, to_string
+
+#include "ftxui/dom/elements.hpp"   // for virtualList, text, frame, ...
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(VirtualListTest, Basic) {
+  int built = 0;
+  auto list = virtualList(1000000, 1, [&](int i) {
+    built++;
+    return text(std::to_string(i));
+  });
+  Screen screen(4, 3);
+  Render(screen, list | frame);
+  EXPECT_EQ(screen.ToString(),
+            "0   \r\n"
+            "1   \r\n"
+            "2   ");
+  // The visible rows, and the overscan below them.
+  EXPECT_EQ(built, 5);
+}
+
+TEST(VirtualListTest, Focus) {
+  int built = 0;
+  const int focused = 500000;
+  auto list = virtualList(
+      1000000, 1,
+      [&](int i) {
+        built++;
+        auto row = text(std::to_string(i));
+        return i == focused ? row | focus : row;
+      },
+      focused);
+  Screen screen(6, 3);
+  Render(screen, list | frame);
+  EXPECT_EQ(screen.ToString(),
+            "499999\r\n"
+            "500000\r\n"
+            "500001");
+  EXPECT_LE(built, 7);
+}
+
+TEST(VirtualListTest, RowHeight) {
+  auto list = virtualList(
+      100, 2,
+      [](int i) {
+        return vbox({
+            text("a" + std::to_string(i)),
+            text("b" + std::to_string(i)),
+        });
+      },
+      10);
+  Screen screen(3, 4);
+  Render(screen, list | focusPositionRelative(0, 0) | frame);
+  EXPECT_EQ(screen.ToString(),
+            "a0 \r\n"
+            "b0 \r\n"
+            "a1 \r\n"
+            "b1 ");
+}
+
+TEST(VirtualListTest, RowHeightFocus) {
+  auto list = virtualList(
+      100, 2,
+      [](int i) {
+        auto row = vbox({
+            text("a" + std::to_string(i)),
+            text("b" + std::to_string(i)),
+        });
+        return i == 10 ? row | focus : row;
+      },
+      10);
+  Screen screen(3, 4);
+  Render(screen, list | frame);
+  // The frame centers the focused row.
+  EXPECT_EQ(screen.ToString(),
+            "b9 \r\n"
+            "a10\r\n"
+            "b10\r\n"
+            "a11");
+}
+
+TEST(VirtualListTest, Empty) {
+  auto list = virtualList(0, 1, [](int /*i*/) { return text("x"); }, 0);
+  Screen screen(3, 3);
+  Render(screen, list | frame | border);
+  EXPECT_EQ(screen.ToString(),
+            "╭─╮\r\n"
+            "│ │\r\n"
+            "╰─╯");
+}
+
+TEST(VirtualListTest, Width) {
+  auto list = virtualList(100, 1, [](int i) {
+    return text("row " + std::to_string(i));
+  });
+  // The first row gives the width of the list.
+  Element document = list | frame | border;
+  EXPECT_EQ(Dimension::Fit(document).dimx, 7);
+
+  Screen screen(7, 3);
+  Render(screen, document);
+  EXPECT_EQ(screen.ToString(),
+            "╭─────╮\r\n"
+            "│row 0│\r\n"
+            "╰─────╯");
+}
+
+TEST(VirtualListTest, WidthFocused) {
+  auto list = virtualList(
+      1000, 1,
+      [](int i) {
+        auto row = text("row " + std::to_string(i));
+        return i == 500 ? row | focus : row;
+      },
+      500);
+  Element document = list | frame | border;
+  EXPECT_EQ(Dimension::Fit(document).dimx, 9);
+}
+
+}  // namespace ftxui
+// NOLINTEND
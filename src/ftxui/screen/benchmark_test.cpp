@@ -0,0 +1,130 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <benchmark/benchmark.h>
+#include <cstdint>  // for uint32_t, int64_t
+#include <string>   // for string
+
+#include "ftxui/screen/string.hpp"           // for string_width, Utf8ToGlyphs, Utf8Glyphs
+#include "ftxui/screen/string_internal.hpp"  // for GlyphCount, CellToGlyphIndex, IsFullWidth, IsFullWidthReference
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+
+// About 4KB of text of a given kind.
+std::string Text(int kind) {
+  const char* pattern = "";
+  switch (kind) {
+    case 0:
+      pattern = "The quick brown fox jumps over the lazy dog. ";
+      break;
+    case 1:
+      pattern = "Être ou ne pas être, voilà la question. Ça déçoit. ";
+      break;
+    case 2:
+      pattern = "天地玄黄，宇宙洪荒。日月盈昃，辰宿列张。";
+      break;
+    case 3:
+      pattern = "🪐🚀 launch 🌍🌕 landing 👩‍🚀 ";
+      break;
+  }
+  std::string out;
+  while (out.size() < 4096) {
+    out += pattern;
+  }
+  return out;
+}
+
+}  // namespace
+
+// Argument: 0=ASCII, 1=Latin-1, 2=CJK, 3=emoji.
+static void BenchmarkStringWidth(benchmark::State& state) {
+  const std::string text = Text(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(string_width(text));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BenchmarkStringWidth)->DenseRange(0, 3);
+
+static void BenchmarkUtf8ToGlyphs(benchmark::State& state) {
+  const std::string text = Text(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Utf8ToGlyphs(text));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BenchmarkUtf8ToGlyphs)->DenseRange(0, 3);
+
+static void BenchmarkUtf8Glyphs(benchmark::State& state) {
+  const std::string text = Text(state.range(0));
+  for (auto _ : state) {
+    int width = 0;
+    for (const GlyphView& glyph : Utf8Glyphs(text)) {
+      width += glyph.width;
+    }
+    benchmark::DoNotOptimize(width);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BenchmarkUtf8Glyphs)->DenseRange(0, 3);
+
+static void BenchmarkGlyphCount(benchmark::State& state) {
+  const std::string text = Text(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GlyphCount(text));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BenchmarkGlyphCount)->DenseRange(0, 3);
+
+static void BenchmarkCellToGlyphIndex(benchmark::State& state) {
+  const std::string text = Text(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CellToGlyphIndex(text));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BenchmarkCellToGlyphIndex)->DenseRange(0, 3);
+
+// Look up the properties of every codepoint of a block.
+// Argument: first codepoint. Latin, CJK, emoji, supplementary ideographs.
+static void BenchmarkCodepointProperties(benchmark::State& state) {
+  const uint32_t first = uint32_t(state.range(0));
+  for (auto _ : state) {
+    for (uint32_t ucs = first; ucs < first + 0x1000; ++ucs) {
+      benchmark::DoNotOptimize(IsFullWidth(ucs));
+      benchmark::DoNotOptimize(IsCombining(ucs));
+      benchmark::DoNotOptimize(CodepointToWordBreakProperty(ucs));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 0x1000);
+}
+BENCHMARK(BenchmarkCodepointProperties)
+    ->Arg(0x0000)
+    ->Arg(0x4E00)
+    ->Arg(0x1F000)
+    ->Arg(0x20000);
+
+// The same, using the binary search into the Unicode intervals.
+static void BenchmarkCodepointPropertiesReference(benchmark::State& state) {
+  const uint32_t first = uint32_t(state.range(0));
+  for (auto _ : state) {
+    for (uint32_t ucs = first; ucs < first + 0x1000; ++ucs) {
+      benchmark::DoNotOptimize(IsFullWidthReference(ucs));
+      benchmark::DoNotOptimize(IsCombiningReference(ucs));
+      benchmark::DoNotOptimize(CodepointToWordBreakPropertyReference(ucs));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 0x1000);
+}
+BENCHMARK(BenchmarkCodepointPropertiesReference)
+    ->Arg(0x0000)
+    ->Arg(0x4E00)
+    ->Arg(0x1F000)
+    ->Arg(0x20000);
+
+}  // namespace ftxui
+// NOLINTEND
@@ -6,15 +6,13 @@
 #include <array>  // for array
 #include <cmath>
 #include <cstdint>
-#include <string_view>  // for literals
+#include <string>  // for string
 
 #include "ftxui/screen/color_info.hpp"  // for GetColorInfo, ColorInfo
 #include "ftxui/screen/terminal.hpp"  // for ColorSupport, Color, Palette256, TrueColor
 
 namespace ftxui {
 
-using namespace std::literals;
-
 namespace {
 const std::array<const char*, 33> palette16code = {
     "30", "40",   //
@@ -35,6 +33,34 @@ const std::array<const char*, 33> palette16code = {
     "97", "107",  //
 };
 
+// The decimal representation of every uint8_t.
+struct Digits {
+  std::array<char, 3> data;
+  uint8_t size;
+};
+
+constexpr std::array<Digits, 256> MakeDigitsTable() {
+  std::array<Digits, 256> table{};
+  for (int i = 0; i < 256; ++i) {  // NOLINT
+    Digits& digits = table[i];     // NOLINT
+    if (i >= 100) {                // NOLINT
+      digits.data[digits.size++] = char('0' + i / 100);  // NOLINT
+    }
+    if (i >= 10) {  // NOLINT
+      digits.data[digits.size++] = char('0' + i / 10 % 10);  // NOLINT
+    }
+    digits.data[digits.size++] = char('0' + i % 10);  // NOLINT
+  }
+  return table;
+}
+
+constexpr std::array<Digits, 256> digits_table = MakeDigitsTable();
+
+void AppendNumber(std::string& out, uint8_t value) {
+  const Digits& digits = digits_table[value];
+  out.append(digits.data.data(), digits.size);
+}
+
 }  // namespace
 
 bool Color::operator==(const Color& rhs) const {
@@ -47,22 +73,39 @@ bool Color::operator!=(const Color& rhs) const {
 }
 
 std::string Color::Print(bool is_background_color) const {
+  std::string out;
+  Print(out, is_background_color);
+  return out;
+}
+
+/// @brief Append to |out| the SGR parameters selecting this color, without
+/// allocating.
+/// @param out The buffer to append to.
+/// @param is_background_color Whether the color is used as a background.
+void Color::Print(std::string& out, bool is_background_color) const {
   switch (type_) {
     case ColorType::Palette1:
-      return is_background_color ? "49"s : "39"s;
+      out += is_background_color ? "49" : "39";
+      return;
 
     case ColorType::Palette16:
-      return palette16code[2 * red_ + is_background_color];  // NOLINT;
+      out += palette16code[2 * red_ + is_background_color];  // NOLINT;
+      return;
 
     case ColorType::Palette256:
-      return (is_background_color ? "48;5;"s : "38;5;"s) + std::to_string(red_);
+      out += is_background_color ? "48;5;" : "38;5;";
+      AppendNumber(out, red_);
+      return;
 
     case ColorType::TrueColor:
     default:
-      return (is_background_color ? "48;2;"s : "38;2;"s)  //
-             + std::to_string(red_) + ";"                 //
-             + std::to_string(green_) + ";"               //
-             + std::to_string(blue_);                     //
+      out += is_background_color ? "48;2;" : "38;2;";
+      AppendNumber(out, red_);
+      out += ';';
+      AppendNumber(out, green_);
+      out += ';';
+      AppendNumber(out, blue_);
+      return;
   }
 }
 
@@ -0,0 +1,228 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/screen/grapheme.hpp"
+
+#include <algorithm>      // for min
+#include <array>          // for array
+#include <atomic>         // for atomic, memory_order_acquire, memory_order_release
+#include <cstdint>        // for uint32_t, uint8_t
+#include <cstring>        // for memcpy
+#include <mutex>          // for mutex, lock_guard
+#include <ostream>        // for ostream
+#include <string>         // for string
+#include <string_view>    // for string_view
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "ftxui/screen/grapheme_internal.hpp"  // for InternedGraphemeCount, SetInternedGraphemeCapacity
+
+namespace ftxui {
+
+namespace {
+
+// The number of graphemes the pool can hold: the index is stored in 3 bytes.
+constexpr uint32_t kPoolCapacity = 1U << 24U;
+
+// The pool is an array of chunks, allocated on demand.
+constexpr uint32_t kChunkBits = 12U;
+constexpr uint32_t kChunkSize = 1U << kChunkBits;
+constexpr uint32_t kChunkCount = kPoolCapacity / kChunkSize;
+
+struct Entry {
+  std::string str;
+  std::atomic<uint32_t> references = 0;
+};
+
+// Graphemes too long to be stored inline. They are shared in between every
+// screens, so that pixels can be compared and copied from one to another.
+//
+// Entries are added and removed under the mutex. An entry is only modified
+// while nobody references it, so it is read without locking. The entries
+// released are reused by the next graphemes.
+struct Pool {
+  std::mutex mutex;
+  std::unordered_map<std::string_view, uint32_t> index;
+  std::vector<uint32_t> free;
+  uint32_t size = 0;
+  uint32_t capacity = kPoolCapacity;
+  std::array<std::atomic<Entry*>, kChunkCount> chunks = {};
+};
+
+Pool& GetPool() {
+  static auto* pool = new Pool();  // NOLINT: Never destroyed.
+  return *pool;
+}
+
+Entry& GetEntry(uint32_t id) {
+  Entry* chunk =
+      GetPool().chunks[id >> kChunkBits].load(std::memory_order_acquire);
+  return chunk[id % kChunkSize];  // NOLINT
+}
+
+// Return the index of |str| in the pool, referenced once more. Return
+// kPoolCapacity when the pool is full.
+uint32_t Intern(std::string_view str) {
+  Pool& pool = GetPool();
+  const std::lock_guard<std::mutex> lock(pool.mutex);
+  auto it = pool.index.find(str);
+  if (it != pool.index.end()) {
+    GetEntry(it->second).references.fetch_add(1, std::memory_order_relaxed);
+    return it->second;
+  }
+
+  if (pool.index.size() >= pool.capacity) {
+    return kPoolCapacity;
+  }
+
+  uint32_t id = 0;
+  if (pool.free.empty()) {
+    id = pool.size++;
+    std::atomic<Entry*>& chunk = pool.chunks[id >> kChunkBits];
+    if (chunk.load(std::memory_order_relaxed) == nullptr) {
+      chunk.store(new Entry[kChunkSize],  // NOLINT: Never destroyed.
+                  std::memory_order_release);
+    }
+  } else {
+    id = pool.free.back();
+    pool.free.pop_back();
+  }
+
+  Entry& entry = GetEntry(id);
+  entry.str = str;
+  entry.references.store(1, std::memory_order_relaxed);
+  pool.index[entry.str] = id;
+  return id;
+}
+
+// The first codepoint of |str|, without the bytes that can't be stored inline.
+// This is displayed instead of the graphemes that can't be interned.
+std::string_view BaseCodepoint(std::string_view str) {
+  const auto lead = uint8_t(str[0]);
+  size_t size = lead < 0xC0 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;  // NOLINT
+  size = std::min(size, str.size());
+  for (size_t i = 0; i < size; ++i) {
+    if (str[i] == '\0' || uint8_t(str[i]) == 0xFF) {  // NOLINT
+      size = i;
+      break;
+    }
+  }
+  return str.substr(0, size);
+}
+
+bool IsInlinable(std::string_view str) {
+  if (str.size() > 4) {
+    return false;
+  }
+  for (const char c : str) {
+    if (c == '\0' || uint8_t(c) == 0xFF) {  // NOLINT
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Grapheme::Grapheme(std::string_view str) {
+  if (!IsInlinable(str)) {
+    const uint32_t id = Intern(str);
+    if (id != kPoolCapacity) {
+      data_[0] = kInterned;
+      data_[1] = uint8_t(id);         // NOLINT
+      data_[2] = uint8_t(id >> 8U);   // NOLINT
+      data_[3] = uint8_t(id >> 16U);  // NOLINT
+      return;
+    }
+    // The pool is full.
+    str = BaseCodepoint(str);
+  }
+
+  for (size_t i = 0; i < 4; ++i) {
+    data_[i] = i < str.size() ? uint8_t(str[i]) : 0;  // NOLINT
+  }
+}
+
+std::string_view Grapheme::view() const {
+  if (!IsInterned()) {
+    return {reinterpret_cast<const char*>(data_), size()};  // NOLINT
+  }
+
+  return GetEntry(Id()).str;
+}
+
+size_t Grapheme::size() const {
+  if (IsInterned()) {
+    return view().size();
+  }
+  // clang-format off
+  return data_[3] ? 4 :
+         data_[2] ? 3 :
+         data_[1] ? 2 :
+         data_[0] ? 1 :
+                    0;
+  // clang-format on
+}
+
+const char* Grapheme::c_str() const {
+  // The interned strings are std::string. The inline ones shorter than 4 bytes
+  // are followed by a null byte.
+  if (IsInterned() || data_[3] == 0) {
+    return view().data();
+  }
+  thread_local char buffer[5] = {};  // NOLINT
+  std::memcpy(buffer, data_, 4);     // NOLINT
+  return buffer;                     // NOLINT
+}
+
+Grapheme& Grapheme::operator+=(std::string_view str) {
+  if (!str.empty()) {
+    std::string concatenated(view());
+    concatenated += str;
+    *this = Grapheme(concatenated);
+  }
+  return *this;
+}
+
+void Grapheme::RetainInterned(uint32_t id) {
+  GetEntry(id).references.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Grapheme::ReleaseInterned(uint32_t id) {
+  Entry& entry = GetEntry(id);
+  if (entry.references.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+
+  // The grapheme may have been interned again, and even released by another
+  // thread, before the lock is taken. It is removed only once.
+  Pool& pool = GetPool();
+  const std::lock_guard<std::mutex> lock(pool.mutex);
+  if (entry.references.load(std::memory_order_relaxed) != 0) {
+    return;
+  }
+  auto it = pool.index.find(entry.str);
+  if (it == pool.index.end() || it->second != id) {
+    return;
+  }
+  pool.index.erase(it);
+  pool.free.push_back(id);
+}
+
+size_t InternedGraphemeCount() {
+  Pool& pool = GetPool();
+  const std::lock_guard<std::mutex> lock(pool.mutex);
+  return pool.index.size();
+}
+
+void SetInternedGraphemeCapacity(uint32_t capacity) {
+  Pool& pool = GetPool();
+  const std::lock_guard<std::mutex> lock(pool.mutex);
+  pool.capacity = std::min(capacity, kPoolCapacity);
+}
+
+std::ostream& operator<<(std::ostream& out, const Grapheme& grapheme) {
+  return out << grapheme.view();
+}
+
+}  // namespace ftxui
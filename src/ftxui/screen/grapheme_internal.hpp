@@ -0,0 +1,21 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_SCREEN_GRAPHEME_INTERNAL_HPP
+#define FTXUI_SCREEN_GRAPHEME_INTERNAL_HPP
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
+
+namespace ftxui {
+
+// The number of graphemes currently interned into the pool.
+size_t InternedGraphemeCount();
+
+// Limit the number of graphemes interned at the same time. This is used by the
+// tests, instead of filling the 2^24 entries of the pool.
+void SetInternedGraphemeCapacity(uint32_t capacity);
+
+}  // namespace ftxui
+
+#endif  // FTXUI_SCREEN_GRAPHEME_INTERNAL_HPP
@@ -0,0 +1,137 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <string>  // for string, to_string
+#include <thread>  // for thread
+#include <vector>  // for vector
+
+#include "ftxui/screen/grapheme.hpp"           // for Grapheme
+#include "ftxui/screen/grapheme_internal.hpp"  // for InternedGraphemeCount, SetInternedGraphemeCapacity
+#include "ftxui/screen/screen.hpp"             // for Pixel, Screen
+
+namespace ftxui {
+
+TEST(GraphemeTest, Default) {
+  EXPECT_EQ(Grapheme(), " ");
+  EXPECT_EQ(Grapheme().size(), 1u);
+  EXPECT_EQ(Grapheme(), Pixel().character);
+}
+
+TEST(GraphemeTest, Inline) {
+  EXPECT_EQ(Grapheme(""), "");
+  EXPECT_TRUE(Grapheme("").empty());
+  EXPECT_EQ(Grapheme("a"), "a");
+  EXPECT_EQ(Grapheme("─").size(), 3u);
+  EXPECT_EQ(Grapheme("测"), std::string("测"));
+  EXPECT_EQ(Grapheme("😀").str(), "😀");
+  EXPECT_NE(Grapheme("a"), Grapheme("b"));
+  EXPECT_NE(Grapheme("a"), Grapheme(""));
+}
+
+TEST(GraphemeTest, Interned) {
+  const std::string combining = "a⃦";
+  const Grapheme a(combining);
+  const Grapheme b(combining);
+  EXPECT_EQ(a, combining);
+  EXPECT_EQ(a.size(), combining.size());
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, Grapheme("a"));
+  EXPECT_EQ(Grapheme("┏━"), "┏━");
+
+  // Strings containing bytes that could be confused with the encoding.
+  EXPECT_EQ(Grapheme(std::string(1, '\0')).size(), 1u);
+  EXPECT_EQ(Grapheme("\xFF"), "\xFF");
+}
+
+TEST(GraphemeTest, InternedConcurrently) {
+  // Enough graphemes to span several chunks of the pool.
+  const auto build = [](int thread, int i) {
+    return "a⃦" + std::to_string(thread) + "-" + std::to_string(i);
+  };
+  std::vector<std::thread> threads;
+  std::vector<int> errors(4, 0);
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      std::vector<Grapheme> graphemes;
+      for (int i = 0; i < 5000; ++i) {
+        graphemes.emplace_back(build(t, i));
+        // An earlier one, read while the other threads append.
+        const int j = i / 2;
+        errors[t] += graphemes[j] != build(t, j);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(errors, std::vector<int>(4, 0));
+  EXPECT_EQ(Grapheme(build(3, 4999)), build(3, 4999));
+}
+
+TEST(GraphemeTest, Released) {
+  const size_t count = InternedGraphemeCount();
+  {
+    std::vector<Grapheme> graphemes;
+    for (int i = 0; i < 1000; ++i) {
+      graphemes.emplace_back("a⃦" + std::to_string(i));
+    }
+    EXPECT_EQ(InternedGraphemeCount(), count + 1000);
+
+    // The copies keep the graphemes alive.
+    const Grapheme copy = graphemes[10];
+    graphemes.clear();
+    EXPECT_EQ(InternedGraphemeCount(), count + 1);
+    EXPECT_EQ(copy, "a⃦10");
+  }
+  EXPECT_EQ(InternedGraphemeCount(), count);
+
+  // The graphemes written into a screen are released by Clear().
+  Screen screen(10, 10);
+  for (int i = 0; i < 100; ++i) {
+    screen.PixelAt(i % 10, i / 10).character = "a⃦" + std::to_string(i);
+  }
+  EXPECT_EQ(InternedGraphemeCount(), count + 100);
+  screen.Clear();
+  EXPECT_EQ(InternedGraphemeCount(), count);
+}
+
+TEST(GraphemeTest, PoolFull) {
+  const Grapheme interned("a⃦ interned");
+  SetInternedGraphemeCapacity(0);
+
+  // The graphemes already interned are still shared.
+  EXPECT_EQ(Grapheme("a⃦ interned"), "a⃦ interned");
+
+  // The new ones are reduced to their first codepoint.
+  EXPECT_EQ(Grapheme("a⃦ new"), "a");
+  EXPECT_EQ(Grapheme("测⃦ new"), "测");
+  EXPECT_EQ(Grapheme(std::string("\0a", 2)), "");
+  EXPECT_EQ(Grapheme("\xFF"), "");
+
+  SetInternedGraphemeCapacity(1U << 24U);
+  EXPECT_EQ(Grapheme("a⃦ new"), "a⃦ new");
+}
+
+TEST(GraphemeTest, StringOperations) {
+  EXPECT_STREQ(Grapheme("").c_str(), "");
+  EXPECT_STREQ(Grapheme("a").c_str(), "a");
+  EXPECT_STREQ(Grapheme("─").c_str(), "─");
+  EXPECT_STREQ(Grapheme("😀").c_str(), "😀");
+  EXPECT_STREQ(Grapheme("a⃦").c_str(), "a⃦");
+
+  // Combining characters are appended to the content of a cell.
+  Screen screen(2, 1);
+  screen.at(0, 0) = "a";
+  screen.at(0, 0) += "⃦";
+  screen.at(0, 0) += std::string("⃦");
+  screen.at(1, 0) += "";
+  EXPECT_EQ(screen.at(0, 0), "a⃦⃦");
+  EXPECT_EQ(screen.at(1, 0), " ");
+}
+
+TEST(GraphemeTest, PixelSize) {
+  EXPECT_LT(sizeof(Pixel), 16u);
+}
+
+}  // namespace ftxui
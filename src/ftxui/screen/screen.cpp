@@ -1,13 +1,25 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <cstdint>  // for size_t
+#include <algorithm>  // for fill_n, max, min
+#include <array>      // for array
+#include <charconv>   // for to_chars
+#include <condition_variable>  // for condition_variable
+#include <cstdint>    // for size_t, uint64_t
+#include <cstdlib>    // for abs
+#include <cstring>    // for memcmp, memcpy
+#include <functional>  // for function
 #include <iostream>  // for operator<<, stringstream, basic_ostream, flush, cout, ostream
 #include <limits>
-#include <map>      // for _Rb_tree_const_iterator, map, operator!=, operator==
 #include <memory>   // for allocator, allocator_traits<>::value_type
+#include <mutex>    // for mutex, lock_guard, unique_lock
 #include <sstream>  // IWYU pragma: keep
-#include <utility>  // for pair
+#include <string_view>  // for string_view
+#include <system_error>  // for system_error
+#include <thread>       // for thread
+#include <tuple>        // for ignore
+#include <utility>      // for pair
+#include <vector>       // for vector
 
 #include "ftxui/screen/screen.hpp"
 #include "ftxui/screen/string.hpp"    // for string_width
@@ -70,84 +82,131 @@ void WindowsEmulateVT100Terminal() {
 }
 #endif
 
+// Append the decimal representation of |value| to |out|.
+void AppendNumber(std::string& out, int value) {
+  std::array<char, 16> buffer{};
+  const auto result =
+      std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+  out.append(buffer.data(), result.ptr);
+}
+
+// Append the sequences transforming the style of |prev| into the one of
+// |next|. Every SGR attribute change is combined into a single CSI sequence.
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 void UpdatePixelStyle(const Screen* screen,
-                      std::stringstream& ss,
+                      std::string& out,
                       const Pixel& prev,
                       const Pixel& next) {
   // See https://gist.github.com/egmontkob/eb114294efbcd5adb1944c9f3cb5feda
   if (FTXUI_UNLIKELY(next.hyperlink != prev.hyperlink)) {
-    ss << "\x1B]8;;" << screen->Hyperlink(next.hyperlink) << "\x1B\\";
+    out += "\x1B]8;;";
+    out += screen->Hyperlink(next.hyperlink);
+    out += "\x1B\\";
   }
 
+  const size_t start = out.size();
+  out += "\x1B[";
+  const size_t parameters_start = out.size();
+  const auto separator = [&] {
+    if (out.size() != parameters_start) {
+      out += ';';
+    }
+  };
+  const auto parameter = [&](const char* value) {
+    separator();
+    out += value;
+  };
+
   // Bold
   if (FTXUI_UNLIKELY((next.bold ^ prev.bold) | (next.dim ^ prev.dim))) {
-    // BOLD_AND_DIM_RESET:
-    ss << ((prev.bold && !next.bold) || (prev.dim && !next.dim) ? "\x1B[22m"
-                                                                : "");
-    ss << (next.bold ? "\x1B[1m" : "");  // BOLD_SET
-    ss << (next.dim ? "\x1B[2m" : "");   // DIM_SET
+    if ((prev.bold && !next.bold) || (prev.dim && !next.dim)) {
+      parameter("22");  // BOLD_AND_DIM_RESET
+    }
+    if (next.bold) {
+      parameter("1");  // BOLD_SET
+    }
+    if (next.dim) {
+      parameter("2");  // DIM_SET
+    }
   }
 
   // Underline
   if (FTXUI_UNLIKELY(next.underlined != prev.underlined ||
                      next.underlined_double != prev.underlined_double)) {
-    ss << (next.underlined          ? "\x1B[4m"     // UNDERLINE
-           : next.underlined_double ? "\x1B[21m"    // UNDERLINE_DOUBLE
-                                    : "\x1B[24m");  // UNDERLINE_RESET
+    parameter(next.underlined          ? "4"     // UNDERLINE
+              : next.underlined_double ? "21"    // UNDERLINE_DOUBLE
+                                       : "24");  // UNDERLINE_RESET
   }
 
   // Blink
   if (FTXUI_UNLIKELY(next.blink != prev.blink)) {
-    ss << (next.blink ? "\x1B[5m"     // BLINK_SET
-                      : "\x1B[25m");  // BLINK_RESET
+    parameter(next.blink ? "5"     // BLINK_SET
+                         : "25");  // BLINK_RESET
   }
 
   // Inverted
   if (FTXUI_UNLIKELY(next.inverted != prev.inverted)) {
-    ss << (next.inverted ? "\x1B[7m"     // INVERTED_SET
-                         : "\x1B[27m");  // INVERTED_RESET
+    parameter(next.inverted ? "7"     // INVERTED_SET
+                            : "27");  // INVERTED_RESET
   }
 
   // StrikeThrough
   if (FTXUI_UNLIKELY(next.strikethrough != prev.strikethrough)) {
-    ss << (next.strikethrough ? "\x1B[9m"     // CROSSED_OUT
-                              : "\x1B[29m");  // CROSSED_OUT_RESET
+    parameter(next.strikethrough ? "9"     // CROSSED_OUT
+                                 : "29");  // CROSSED_OUT_RESET
   }
 
   if (FTXUI_UNLIKELY(next.foreground_color != prev.foreground_color ||
                      next.background_color != prev.background_color)) {
-    ss << "\x1B[" + next.foreground_color.Print(false) + "m";
-    ss << "\x1B[" + next.background_color.Print(true) + "m";
+    separator();
+    next.foreground_color.Print(out, false);
+    out += ';';
+    next.background_color.Print(out, true);
+  }
+
+  if (out.size() == parameters_start) {
+    out.resize(start);  // Nothing changed.
+  } else {
+    out += 'm';
   }
 }
 
 struct TileEncoding {
-  uint8_t left : 2;
-  uint8_t top : 2;
-  uint8_t right : 2;
-  uint8_t down : 2;
-  uint8_t round : 1;
+  uint8_t left;
+  uint8_t top;
+  uint8_t right;
+  uint8_t down;
+  uint8_t round;
+};
 
-  // clang-format off
-  bool operator<(const TileEncoding& other) const {
-    if (left < other.left)   { return  true;  }
-    if (left > other.left)   { return  false; }
-    if (top < other.top)     { return  true;  }
-    if (top > other.top)     { return  false; }
-    if (right < other.right) { return  true;  }
-    if (right > other.right) { return  false; }
-    if (down < other.down)   { return  true;  }
-    if (down > other.down)   { return  false; }
-    if (round < other.round) { return  true;  }
-    if (round > other.round) { return  false; }
-      return false;
-  }
-  // clang-format on
+// A TileEncoding packed into an integer: 2 bits per direction, and the round
+// bit.
+using TileCode = uint16_t;
+constexpr TileCode kNoTile = 0xFFFF;
+constexpr int kTileLeft = 0;
+constexpr int kTileTop = 2;
+constexpr int kTileRight = 4;
+constexpr int kTileDown = 6;
+constexpr int kTileRound = 8;
+constexpr int kTileCodes = 1 << 9;
+
+constexpr TileCode Pack(const TileEncoding& encoding) {
+  return TileCode(encoding.left << kTileLeft | encoding.top << kTileTop |
+                  encoding.right << kTileRight | encoding.down << kTileDown |
+                  encoding.round << kTileRound);
+}
+
+constexpr int TileSide(TileCode code, int side) {
+  return (code >> side) & 3;  // NOLINT
+}
+
+struct Tile {
+  const char* glyph;
+  TileEncoding encoding;
 };
 
 // clang-format off
-const std::map<std::string, TileEncoding> tile_encoding = { // NOLINT
+constexpr Tile tiles[] = {
     {"─", {1, 0, 1, 0, 0}},
     {"━", {2, 0, 2, 0, 0}},
     {"╍", {2, 0, 2, 0, 0}},
@@ -290,73 +349,112 @@ const std::map<std::string, TileEncoding> tile_encoding = { // NOLINT
 };
 // clang-format on
 
-template <class A, class B>
-std::map<B, A> InvertMap(const std::map<A, B> input) {
-  std::map<B, A> output;
-  for (const auto& it : input) {
-    output[it.second] = it.first;
+// The box drawing characters are in the block U+2500-U+257F. Their UTF-8
+// encoding is: E2 94 80 to E2 95 BF.
+constexpr int kBoxDrawingCount = 128;
+constexpr uint8_t kNoGlyph = 0xFF;
+
+constexpr int BoxDrawingIndex(uint8_t b1, uint8_t b2) {
+  return (b1 - 0x94) * 64 + (b2 - 0x80);  // NOLINT
+}
+
+struct TileTables {
+  std::array<TileCode, kBoxDrawingCount> code_of_glyph = {};
+  std::array<uint8_t, kTileCodes> glyph_of_code = {};
+};
+
+constexpr TileTables MakeTileTables() {
+  TileTables tables;
+  for (auto& code : tables.code_of_glyph) {
+    code = kNoTile;
   }
-  return output;
+  for (auto& glyph : tables.glyph_of_code) {
+    glyph = kNoGlyph;
+  }
+  for (const Tile& tile : tiles) {
+    const int index = BoxDrawingIndex(uint8_t(tile.glyph[1]),  // NOLINT
+                                      uint8_t(tile.glyph[2]));  // NOLINT
+    tables.code_of_glyph[index] = Pack(tile.encoding);
+  }
+  // When several characters share the same encoding, the last one is used.
+  for (int index = 0; index < kBoxDrawingCount; ++index) {
+    const TileCode code = tables.code_of_glyph[index];
+    if (code != kNoTile) {
+      tables.glyph_of_code[code] = uint8_t(index);
+    }
+  }
+  return tables;
 }
 
-const std::map<TileEncoding, std::string> tile_encoding_inverse =  // NOLINT
-    InvertMap(tile_encoding);
+constexpr TileTables tile_tables = MakeTileTables();
+
+TileCode GetTileCode(const Grapheme& grapheme) {
+  const std::string_view str = grapheme.view();
+  if (str.size() != 3 || uint8_t(str[0]) != 0xE2) {  // NOLINT
+    return kNoTile;
+  }
+  const auto b1 = uint8_t(str[1]);
+  const auto b2 = uint8_t(str[2]);
+  if (b1 < 0x94 || b1 > 0x95 || b2 < 0x80 || b2 > 0xBF) {  // NOLINT
+    return kNoTile;
+  }
+  return tile_tables.code_of_glyph[BoxDrawingIndex(b1, b2)];
+}
+
+void SetTileCode(Grapheme& grapheme, TileCode code) {
+  const uint8_t index = tile_tables.glyph_of_code[code];
+  if (index == kNoGlyph) {
+    return;
+  }
+  const char str[] = {
+      '\xE2',
+      char(0x94 + index / 64),  // NOLINT
+      char(0x80 + index % 64),  // NOLINT
+  };
+  grapheme = Grapheme(std::string_view(str, 3));
+}
 
-void UpgradeLeftRight(std::string& left, std::string& right) {
-  const auto it_left = tile_encoding.find(left);
-  if (it_left == tile_encoding.end()) {
+void UpgradeLeftRight(Grapheme& left, Grapheme& right) {
+  const TileCode code_left = GetTileCode(left);
+  if (code_left == kNoTile) {
     return;
   }
-  const auto it_right = tile_encoding.find(right);
-  if (it_right == tile_encoding.end()) {
+  const TileCode code_right = GetTileCode(right);
+  if (code_right == kNoTile) {
     return;
   }
 
-  if (it_left->second.right == 0 && it_right->second.left != 0) {
-    TileEncoding encoding_left = it_left->second;
-    encoding_left.right = it_right->second.left;
-    const auto it_left_upgrade = tile_encoding_inverse.find(encoding_left);
-    if (it_left_upgrade != tile_encoding_inverse.end()) {
-      left = it_left_upgrade->second;
-    }
+  const int left_right = TileSide(code_left, kTileRight);
+  const int right_left = TileSide(code_right, kTileLeft);
+
+  if (left_right == 0 && right_left != 0) {
+    SetTileCode(left, code_left | right_left << kTileRight);
   }
 
-  if (it_right->second.left == 0 && it_left->second.right != 0) {
-    TileEncoding encoding_right = it_right->second;
-    encoding_right.left = it_left->second.right;
-    const auto it_right_upgrade = tile_encoding_inverse.find(encoding_right);
-    if (it_right_upgrade != tile_encoding_inverse.end()) {
-      right = it_right_upgrade->second;
-    }
+  if (right_left == 0 && left_right != 0) {
+    SetTileCode(right, code_right | left_right << kTileLeft);
   }
 }
 
-void UpgradeTopDown(std::string& top, std::string& down) {
-  const auto it_top = tile_encoding.find(top);
-  if (it_top == tile_encoding.end()) {
+void UpgradeTopDown(Grapheme& top, Grapheme& down) {
+  const TileCode code_top = GetTileCode(top);
+  if (code_top == kNoTile) {
     return;
   }
-  const auto it_down = tile_encoding.find(down);
-  if (it_down == tile_encoding.end()) {
+  const TileCode code_down = GetTileCode(down);
+  if (code_down == kNoTile) {
     return;
   }
 
-  if (it_top->second.down == 0 && it_down->second.top != 0) {
-    TileEncoding encoding_top = it_top->second;
-    encoding_top.down = it_down->second.top;
-    const auto it_top_down = tile_encoding_inverse.find(encoding_top);
-    if (it_top_down != tile_encoding_inverse.end()) {
-      top = it_top_down->second;
-    }
+  const int top_down = TileSide(code_top, kTileDown);
+  const int down_top = TileSide(code_down, kTileTop);
+
+  if (top_down == 0 && down_top != 0) {
+    SetTileCode(top, code_top | down_top << kTileDown);
   }
 
-  if (it_down->second.top == 0 && it_top->second.down != 0) {
-    TileEncoding encoding_down = it_down->second;
-    encoding_down.top = it_top->second.down;
-    const auto it_down_top = tile_encoding_inverse.find(encoding_down);
-    if (it_down_top != tile_encoding_inverse.end()) {
-      down = it_down_top->second;
-    }
+  if (down_top == 0 && top_down != 0) {
+    SetTileCode(down, code_down | top_down << kTileTop);
   }
 }
 
@@ -364,6 +462,388 @@ bool ShouldAttemptAutoMerge(Pixel& pixel) {
   return pixel.automerge && pixel.character.size() == 3;
 }
 
+// Return whether two pixels, coming from two different screens, are printed
+// identically on the terminal.
+bool IsSamePixel(const Screen& screen_a,
+                 const Pixel& a,
+                 const Screen& screen_b,
+                 const Pixel& b) {
+  // clang-format off
+  return a.character == b.character &&
+         a.foreground_color == b.foreground_color &&
+         a.background_color == b.background_color &&
+         a.blink == b.blink &&
+         a.bold == b.bold &&
+         a.dim == b.dim &&
+         a.inverted == b.inverted &&
+         a.underlined == b.underlined &&
+         a.underlined_double == b.underlined_double &&
+         a.strikethrough == b.strikethrough &&
+         ((a.hyperlink == 0 && b.hyperlink == 0) ||
+          screen_a.Hyperlink(a.hyperlink) == screen_b.Hyperlink(b.hyperlink));
+  // clang-format on
+}
+
+bool IsFullWidth(const Pixel& pixel) {
+  return string_width(pixel.character) == 2;
+}
+
+// Return a row of at least |dimx| blank pixels. It is shared by the successive
+// frames diffed on this thread, instead of being allocated by each of them.
+const Pixel* BlankRow(int dimx) {
+  thread_local std::vector<Pixel> row;
+  if (row.size() < size_t(dimx)) {
+    row.resize(size_t(dimx));
+  }
+  return row.data();
+}
+
+// Return a hash of the way a row is printed. Hyperlinks are identified by their
+// id, so rows from two different screens are compared approximately.
+uint64_t RowHash(const Pixel* row, int dimx) {
+  uint64_t hash = 14695981039346656037ULL;  // NOLINT: FNV-1a offset basis.
+  const auto mix = [&](uint64_t value) {
+    hash ^= value;
+    hash *= 1099511628211ULL;  // NOLINT: FNV-1a prime.
+  };
+  for (int x = 0; x < dimx; ++x) {
+    const Pixel& pixel = row[x];
+    for (const char c : pixel.character.view()) {
+      mix(uint8_t(c));
+    }
+    uint32_t foreground = 0;
+    uint32_t background = 0;
+    std::memcpy(&foreground, &pixel.foreground_color, sizeof(Color));
+    std::memcpy(&background, &pixel.background_color, sizeof(Color));
+    mix(foreground);
+    mix(background);
+    // clang-format off
+    mix(uint64_t(pixel.blink)             << 0U  |  // NOLINT
+        uint64_t(pixel.bold)              << 1U  |  // NOLINT
+        uint64_t(pixel.dim)               << 2U  |  // NOLINT
+        uint64_t(pixel.inverted)          << 3U  |  // NOLINT
+        uint64_t(pixel.underlined)        << 4U  |  // NOLINT
+        uint64_t(pixel.underlined_double) << 5U  |  // NOLINT
+        uint64_t(pixel.strikethrough)     << 6U  |  // NOLINT
+        uint64_t(pixel.hyperlink)         << 8U);   // NOLINT
+    // clang-format on
+  }
+  return hash;
+}
+
+// A region of lines [top, bottom], scrolled by |shift| lines. The content moves
+// up when |shift| is positive, and down otherwise.
+struct Scroll {
+  int top = 0;
+  int bottom = 0;
+  int shift = 0;
+};
+
+// Find the scroll turning the most lines of |previous| into the lines of
+// |current|, given the hash of their rows. Return a zero shift if scrolling
+// isn't worth it.
+Scroll FindScroll(const std::vector<uint64_t>& current,
+                  const std::vector<uint64_t>& previous) {
+  const int dimy = int(current.size());
+  Scroll best;
+  int best_gain = 1;  // Scrolling costs about as much as printing a line.
+  for (int shift = 1; shift < dimy; ++shift) {
+    for (const int direction : {1, -1}) {
+      // Lines [y, y + n) match previous lines [y + k, y + n + k).
+      const int k = shift * direction;
+      const int y_min = std::max(0, -k);
+      const int y_max = std::min(dimy, dimy - k);
+      int y = y_min;
+      while (y < y_max) {
+        if (current[y] != previous[y + k]) {
+          ++y;
+          continue;
+        }
+        const int start = y;
+        int gain = 0;
+        while (y < y_max && current[y] == previous[y + k]) {
+          gain += int(current[y] != previous[y]);
+          ++y;
+        }
+
+        Scroll scroll;
+        scroll.top = std::min(start, start + k);
+        scroll.bottom = std::max(y - 1, y - 1 + k);
+        scroll.shift = k;
+
+        // The exposed lines are drawn again, even if they were unchanged.
+        const int exposed_min = k > 0 ? scroll.bottom - k + 1 : scroll.top;
+        for (int i = exposed_min; i < exposed_min + shift; ++i) {
+          gain -= int(current[i] == previous[i]);
+        }
+
+        if (gain > best_gain) {
+          best_gain = gain;
+          best = scroll;
+        }
+      }
+    }
+  }
+  return best;
+}
+
+// Return whether two pixels of the same screen are printed identically.
+bool IsSameOutput(const Pixel& a, const Pixel& b) {
+  // clang-format off
+  return a.character == b.character &&
+         a.foreground_color == b.foreground_color &&
+         a.background_color == b.background_color &&
+         a.blink == b.blink &&
+         a.bold == b.bold &&
+         a.dim == b.dim &&
+         a.inverted == b.inverted &&
+         a.underlined == b.underlined &&
+         a.underlined_double == b.underlined_double &&
+         a.strikethrough == b.strikethrough &&
+         a.hyperlink == b.hyperlink;
+  // clang-format on
+}
+
+// Return the beginning of the run of default blank cells ending the line.
+int TrailingBlanks(const Pixel* row, int dimx) {
+  const Pixel blank;
+  int x = dimx;
+  while (x > 0 && IsSameOutput(row[x - 1], blank)) {
+    --x;
+  }
+  // Do not split a fullwidth character from the cell it covers.
+  if (x > 0 && x < dimx && IsFullWidth(row[x - 1])) {
+    ++x;
+  }
+  return x;
+}
+
+// Return whether REP can print the pixel's character again: it must be a
+// single codepoint, one cell wide.
+bool IsRepeatable(const Pixel& pixel) {
+  const std::string_view character = pixel.character.view();
+  if (character.empty()) {
+    return false;
+  }
+  const auto lead = uint8_t(character[0]);
+  const size_t codepoint_size = lead < 0x80   ? 1   // NOLINT
+                                : lead < 0xE0 ? 2   // NOLINT
+                                : lead < 0xF0 ? 3   // NOLINT
+                                              : 4;  // NOLINT
+  return codepoint_size == character.size() &&
+         string_width(pixel.character) == 1;
+}
+
+size_t DigitCount(int value) {
+  size_t count = 1;
+  while (value >= 10) {  // NOLINT
+    value /= 10;         // NOLINT
+    ++count;
+  }
+  return count;
+}
+
+// Append the cells [start, end) of a row. After printing a fullwidth
+// character, the next cell is skipped.
+//
+// When |repeat| is set, a run of identical cells is printed once, followed by
+// REP (CSI n b) when it is shorter. The last cell of the screen's line is never
+// repeated, so that the terminal handles the line wrap as usual.
+void EncodeCells(const Screen* screen,
+                 std::string& out,
+                 const Pixel* row,
+                 int start,
+                 int end,
+                 const Pixel*& previous_pixel,
+                 bool repeat) {
+  const int repeat_end = std::min(end, screen->dimx() - 1);
+  bool previous_fullwidth = false;
+  int x = start;
+  while (x < end) {
+    const Pixel& pixel = row[x];
+    if (!previous_fullwidth) {
+      UpdatePixelStyle(screen, out, *previous_pixel, pixel);
+      previous_pixel = &pixel;
+      out += pixel.character.view();
+
+      if (repeat && x + 1 < repeat_end && IsSameOutput(row[x + 1], pixel) &&
+          IsRepeatable(pixel)) {
+        int count = 1;
+        while (x + 1 + count < repeat_end &&
+               IsSameOutput(row[x + 1 + count], pixel)) {
+          ++count;
+        }
+        // Use REP only when it is shorter than the characters.
+        if (count * pixel.character.size() > 3 + DigitCount(count)) {
+          out += "\x1B[";  // REPEAT
+          AppendNumber(out, count);
+          out += 'b';
+          x += count + 1;
+          previous_fullwidth = false;
+          continue;
+        }
+      }
+    }
+    previous_fullwidth = IsFullWidth(pixel);
+    ++x;
+  }
+}
+
+// Append the lines [y_begin, y_end) of the screen, as printed by ToString().
+// The style is the default one before and after them.
+void EncodeLines(const Screen* screen,
+                 std::string& out,
+                 int y_begin,
+                 int y_end,
+                 const Screen::OutputOptions& options) {
+  const int dimx = screen->dimx();
+  const Pixel default_pixel;
+  const Pixel* previous_pixel_ref = &default_pixel;
+
+  for (int y = y_begin; y < y_end; ++y) {
+    // New line in between two lines.
+    if (y != 0) {
+      UpdatePixelStyle(screen, out, *previous_pixel_ref, default_pixel);
+      previous_pixel_ref = &default_pixel;
+      out += "\r\n";
+    }
+
+    const Pixel* row = screen->Row(y);
+
+    // The trailing blank cells are erased instead of being printed. This isn't
+    // done on the last line, where the final cursor position matters.
+    int end = dimx;
+    if (options.erase_line && y != screen->dimy() - 1) {
+      end = screen->WrittenRows()[y] ? TrailingBlanks(row, dimx) : 0;
+      if (dimx - end <= 3) {
+        end = dimx;
+      }
+    }
+
+    EncodeCells(screen, out, row, 0, end, previous_pixel_ref, options.repeat);
+
+    if (end != dimx) {
+      UpdatePixelStyle(screen, out, *previous_pixel_ref, default_pixel);
+      previous_pixel_ref = &default_pixel;
+      out += "\x1B[K";  // ERASE_TO_END_OF_LINE
+    }
+  }
+
+  // Reset the style to default:
+  UpdatePixelStyle(screen, out, *previous_pixel_ref, default_pixel);
+}
+
+#if !defined(__EMSCRIPTEN__)
+// The threads encoding the bands of lines of ToString(). They are started on
+// first use, kept waiting for the next frames, and joined at exit, when the
+// pool is destroyed.
+class EncoderPool {
+ public:
+  static EncoderPool& Get() {
+    static EncoderPool pool;
+    return pool;
+  }
+
+  EncoderPool() = default;
+  EncoderPool(const EncoderPool&) = delete;
+  EncoderPool& operator=(const EncoderPool&) = delete;
+
+  ~EncoderPool() {
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_up_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  // Call |task| for every band in [0, bands). The calling thread takes part,
+  // so every band is done even when no worker could be started.
+  void Run(int bands, const std::function<void(int)>& task) {
+    const std::lock_guard<std::mutex> run_lock(run_mutex_);
+    Grow(bands - 1);
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      next_band_ = 0;
+      bands_ = bands;
+      pending_ = bands;
+      ++generation_;
+    }
+    wake_up_.notify_all();
+    Work();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return pending_ == 0; });
+    task_ = nullptr;
+  }
+
+ private:
+  void Grow(int workers) {
+    while (int(workers_.size()) < workers) {
+      try {
+        workers_.emplace_back(&EncoderPool::Loop, this);
+      } catch (const std::system_error&) {
+        return;
+      }
+    }
+  }
+
+  void Loop() {
+    uint64_t generation = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_up_.wait(lock,
+                      [&] { return stop_ || generation_ != generation; });
+        if (stop_) {
+          return;
+        }
+        generation = generation_;
+      }
+      Work();
+    }
+  }
+
+  // Encode the bands left, one at a time.
+  void Work() {
+    while (true) {
+      const std::function<void(int)>* task = nullptr;
+      int band = 0;
+      {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        if (next_band_ == bands_) {
+          return;
+        }
+        task = task_;
+        band = next_band_++;
+      }
+      (*task)(band);
+      {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) {
+          done_.notify_one();
+        }
+      }
+    }
+  }
+
+  std::mutex run_mutex_;  // One Run() at a time.
+  std::mutex mutex_;
+  std::condition_variable wake_up_;
+  std::condition_variable done_;
+  const std::function<void(int)>* task_ = nullptr;
+  uint64_t generation_ = 0;
+  int next_band_ = 0;
+  int bands_ = 0;
+  int pending_ = 0;
+  bool stop_ = false;
+  std::vector<std::thread> workers_;
+};
+#endif
+
 }  // namespace
 
 /// A fixed dimension.
@@ -396,7 +876,8 @@ Screen::Screen(int dimx, int dimy)
     : stencil{0, dimx - 1, 0, dimy - 1},
       dimx_(dimx),
       dimy_(dimy),
-      pixels_(dimy, std::vector<Pixel>(dimx)) {
+      pixels_(size_t(std::max(dimx, 0)) * size_t(std::max(dimy, 0))),
+      written_rows_(size_t(std::max(dimy, 0)), 0) {
 #if defined(_WIN32)
   // The placement of this call is a bit weird, however we can assume that
   // anybody who instantiates a Screen object eventually wants to output
@@ -414,35 +895,244 @@ Screen::Screen(int dimx, int dimy)
 /// @note Don't forget to flush stdout. Alternatively, you can use
 /// Screen::Print();
 std::string Screen::ToString() const {
-  std::stringstream ss;
+  std::string out;
+  ToString(out);
+  return out;
+}
+
+/// Append to |out| the string to be printed in order to display the screen on
+/// the terminal. Reusing the same buffer in between frames avoids allocations.
+/// @see ToString()
+void Screen::ToString(std::string& out) const {
+  ToString(out, {});
+}
+
+/// Append to |out| the string to be printed in order to display the screen on
+/// the terminal, using the optional terminal features enabled in |options|.
+/// @see ToString()
+void Screen::ToString(std::string& out, const OutputOptions& options) const {
+#if defined(__EMSCRIPTEN__)
+  const int bands = 1;  // No threads.
+#else
+  // More threads than cores would only wait for each other.
+  const int cores = int(std::max(std::thread::hardware_concurrency(), 1U));
+  const int bands = std::min({options.threads, dimy_, cores});
+#endif
+  if (bands <= 1) {
+    EncodeLines(this, out, 0, dimy_, options);
+    return;
+  }
+
+#if !defined(__EMSCRIPTEN__)
+  // Every line starts and ends with the default style, so the bands can be
+  // encoded independently, and concatenated.
+  // The color support is computed lazily. Do it before starting the threads.
+  std::ignore = Terminal::ColorSupport();
+  std::vector<std::string> outputs(bands - 1);
+  const auto band_begin = [&](int band) {
+    return int(int64_t(dimy_) * band / bands);
+  };
+  EncoderPool::Get().Run(bands, [&](int band) {
+    std::string& band_out = band == 0 ? out : outputs[band - 1];
+    EncodeLines(this, band_out, band_begin(band), band_begin(band + 1),
+                options);
+  });
+  for (const std::string& band_out : outputs) {
+    out += band_out;
+  }
+#endif
+}
+
+/// Produce a std::string transforming the `previous` Screen, already displayed
+/// on the terminal, into this one. Only the runs of cells that changed are
+/// printed, the cursor is moved in between them.
+///
+/// Like ToString(), this expects the cursor to be at the top left corner of the
+/// screen. The cursor is left at the beginning of the last line.
+///
+/// If the dimensions of the two screens differ, the whole screen is printed.
+/// @param previous The screen currently displayed on the terminal.
+std::string Screen::ToStringDiff(const Screen& previous) const {
+  std::string out;
+  ToStringDiff(previous, out);
+  return out;
+}
+
+/// Append to |out| the string transforming the `previous` Screen into this one.
+/// @see ToStringDiff(const Screen&)
+void Screen::ToStringDiff(const Screen& previous, std::string& out) const {
+  ToStringDiff(previous, out, {});
+}
+
+/// Append to |out| the string transforming the `previous` Screen into this one,
+/// using the optional terminal features enabled in |options|.
+/// @see ToStringDiff(const Screen&)
+void Screen::ToStringDiff(const Screen& previous,
+                          std::string& out,
+                          const OutputOptions& options) const {
+  if (previous.dimx_ != dimx_ || previous.dimy_ != dimy_) {
+    ToString(out, options);
+    out += '\r';
+    return;
+  }
 
   const Pixel default_pixel;
   const Pixel* previous_pixel_ref = &default_pixel;
 
+  // Rows never written since the last Clear() are blank.
+  const Pixel* blank_line = BlankRow(dimx_);
+  const uint64_t blank_hash = RowHash(blank_line, dimx_);
+
+  // Scroll a region of the terminal when lines moved vertically. The lines
+  // exposed by the scroll are blank.
+  Scroll scroll;
+  if (options.scroll_region && dimy_ > 1) {
+    // Scratch storage, reused by the successive frames diffed on this thread.
+    thread_local std::vector<uint64_t> current_hashes;
+    thread_local std::vector<uint64_t> previous_hashes;
+    current_hashes.resize(size_t(dimy_));
+    previous_hashes.resize(size_t(dimy_));
+    for (int y = 0; y < dimy_; ++y) {
+      current_hashes[y] =
+          written_rows_[y] ? RowHash(Row(y), dimx_) : blank_hash;
+      previous_hashes[y] = previous.written_rows_[y]
+                               ? RowHash(previous.Row(y), dimx_)
+                               : blank_hash;
+    }
+    scroll = FindScroll(current_hashes, previous_hashes);
+  }
+  if (scroll.shift != 0) {
+    out += "\x1B[";  // SET_TOP_AND_BOTTOM_MARGINS
+    AppendNumber(out, scroll.top + 1);
+    out += ';';
+    AppendNumber(out, scroll.bottom + 1);
+    out += 'r';
+    out += "\x1B[";
+    AppendNumber(out, std::abs(scroll.shift));
+    out += scroll.shift > 0 ? 'S' : 'T';  // SCROLL_UP : SCROLL_DOWN
+    out += "\x1B[r";  // RESET_MARGINS. This moves the cursor to the top left.
+  }
+  // Return the index of the line displayed by the terminal, once scrolled, or
+  // -1 when it is a blank line exposed by the scroll.
+  const auto previous_y = [&](int y) {
+    if (scroll.shift == 0 || y < scroll.top || y > scroll.bottom) {
+      return y;
+    }
+    const int y_previous = y + scroll.shift;
+    if (y_previous < scroll.top || y_previous > scroll.bottom) {
+      return -1;
+    }
+    return y_previous;
+  };
+
+  const bool same_hyperlinks = hyperlinks_ == previous.hyperlinks_;
+
+  // The cursor position. `cursor_x` is -1 when unknown. This happens after
+  // printing the last column, depending on the terminal's line wrap handling.
+  int cursor_x = 0;
+  int cursor_y = 0;
+
   for (int y = 0; y < dimy_; ++y) {
-    // New line in between two lines.
-    if (y != 0) {
-      UpdatePixelStyle(this, ss, *previous_pixel_ref, default_pixel);
-      previous_pixel_ref = &default_pixel;
-      ss << "\r\n";
+    const int y_previous = previous_y(y);
+    const bool previous_written =
+        y_previous != -1 && previous.written_rows_[y_previous];
+
+    // Both lines are blank, no need to compare them.
+    if (!written_rows_[y] && !previous_written) {
+      continue;
     }
 
-    // After printing a fullwith character, we need to skip the next cell.
-    bool previous_fullwidth = false;
-    for (const auto& pixel : pixels_[y]) {
-      if (!previous_fullwidth) {
-        UpdatePixelStyle(this, ss, *previous_pixel_ref, pixel);
-        previous_pixel_ref = &pixel;
-        ss << pixel.character;
+    const Pixel* line = Row(y);
+    const Pixel* previous_line =
+        y_previous == -1 ? blank_line : previous.Row(y_previous);
+
+    // Most lines are identical in between two frames. Comparing their bytes is
+    // much faster than comparing their cells one by one. This requires the
+    // hyperlink ids to designate the same links in both screens.
+    if (same_hyperlinks &&
+        std::memcmp(line, previous_line, sizeof(Pixel) * size_t(dimx_)) == 0) {
+      continue;
+    }
+
+    const auto changed = [&](int x) {
+      return !IsSamePixel(*this, line[x], previous, previous_line[x]);
+    };
+
+    int x = 0;
+    while (x < dimx_) {
+      if (!changed(x)) {
+        ++x;
+        continue;
+      }
+
+      // A fullwidth character spans two cells. It must be printed again as a
+      // whole when any of its halves changed.
+      int start = x;
+      if (start > 0 &&
+          (IsFullWidth(line[start - 1]) ||
+           IsFullWidth(previous_line[start - 1]))) {
+        --start;
+      }
+      int end = x + 1;
+      while (end < dimx_ && (changed(end) || IsFullWidth(line[end - 1]) ||
+                             IsFullWidth(previous_line[end - 1]))) {
+        ++end;
+      }
+
+      // Move the cursor to the beginning of the run.
+      if (y != cursor_y) {
+        out += "\x1B[";  // CURSOR_DOWN
+        AppendNumber(out, y - cursor_y);
+        out += 'B';
+        cursor_y = y;
+      }
+      if (start != cursor_x) {
+        if (start == 0) {
+          out += '\r';
+        } else {
+          out += "\x1B[";  // CURSOR_HORIZONTAL_ABSOLUTE
+          AppendNumber(out, start + 1);
+          out += 'G';
+        }
+      }
+
+      // When the run reaches the end of the line, its trailing blank cells can
+      // be erased instead of being printed.
+      int print_end = end;
+      if (options.erase_line && end == dimx_) {
+        print_end = std::max(start, TrailingBlanks(line, dimx_));
+        if (dimx_ - print_end <= 3) {
+          print_end = dimx_;
+        }
       }
-      previous_fullwidth = (string_width(pixel.character) == 2);
+
+      EncodeCells(this, out, line, start, print_end, previous_pixel_ref,
+                  options.repeat);
+
+      if (print_end != end) {
+        UpdatePixelStyle(this, out, *previous_pixel_ref, default_pixel);
+        previous_pixel_ref = &default_pixel;
+        out += "\x1B[K";  // ERASE_TO_END_OF_LINE
+        cursor_x = print_end;
+      } else {
+        cursor_x = end < dimx_ ? end : -1;
+      }
+      x = end;
     }
   }
 
   // Reset the style to default:
-  UpdatePixelStyle(this, ss, *previous_pixel_ref, default_pixel);
+  UpdatePixelStyle(this, out, *previous_pixel_ref, default_pixel);
 
-  return ss.str();
+  // Move the cursor to the beginning of the last line:
+  if (dimy_ - 1 > cursor_y) {
+    out += "\x1B[";  // CURSOR_DOWN
+    AppendNumber(out, dimy_ - 1 - cursor_y);
+    out += 'B';
+  }
+  if (cursor_x != 0) {
+    out += '\r';
+  }
 }
 
 // Print the Screen to the terminal.
@@ -453,14 +1143,14 @@ void Screen::Print() const {
 /// @brief Access a character in a cell at a given position.
 /// @param x The cell position along the x-axis.
 /// @param y The cell position along the y-axis.
-std::string& Screen::at(int x, int y) {
+Grapheme& Screen::at(int x, int y) {
   return PixelAt(x, y).character;
 }
 
 /// @brief Access a character in a cell at a given position.
 /// @param x The cell position along the x-axis.
 /// @param y The cell position along the y-axis.
-const std::string& Screen::at(int x, int y) const {
+const Grapheme& Screen::at(int x, int y) const {
   return PixelAt(x, y).character;
 }
 
@@ -468,14 +1158,42 @@ const std::string& Screen::at(int x, int y) const {
 /// @param x The cell position along the x-axis.
 /// @param y The cell position along the y-axis.
 Pixel& Screen::PixelAt(int x, int y) {
-  return stencil.Contain(x, y) ? pixels_[y][x] : dev_null_pixel();
+  if (!stencil.Contain(x, y)) {
+    return dev_null_pixel();
+  }
+  y -= origin_y_;
+  written_rows_[y] = 1;
+  return pixels_[y * dimx_ + x];
 }
 
 /// @brief Access a cell (Pixel) at a given position.
 /// @param x The cell position along the x-axis.
 /// @param y The cell position along the y-axis.
 const Pixel& Screen::PixelAt(int x, int y) const {
-  return stencil.Contain(x, y) ? pixels_[y][x] : dev_null_pixel();
+  return stencil.Contain(x, y) ? pixels_[(y - origin_y_) * dimx_ + x]
+                               : dev_null_pixel();
+}
+
+/// @brief Access the row of pixels at a given position.
+///
+/// The row is made of dimx() contiguous pixels. This is meant to be used in
+/// hot loops. Contrary to PixelAt(), there are no bounds checks: the caller
+/// must clip the accessed cells against the stencil. The row is marked as
+/// written, see WrittenRows().
+/// @param y The row position along the y-axis.
+Pixel* Screen::Row(int y) {
+  y -= origin_y_;
+  written_rows_[y] = 1;
+  return pixels_.data() + y * dimx_;
+}
+
+/// @brief Access the row of pixels at a given position.
+///
+/// The row is made of dimx() contiguous pixels. Contrary to PixelAt(), there
+/// are no bounds checks.
+/// @param y The row position along the y-axis.
+const Pixel* Screen::Row(int y) const {
+  return pixels_.data() + (y - origin_y_) * dimx_;
 }
 
 /// @brief Return a string to be printed in order to reset the cursor position
@@ -517,17 +1235,49 @@ std::string Screen::ResetPosition(bool clear) const {
 
 /// @brief Clear all the pixel from the screen.
 void Screen::Clear() {
-  for (auto& line : pixels_) {
-    for (auto& cell : line) {
-      cell = Pixel();
+  // The rows not written since the last Clear() are already blank.
+  const Pixel blank;
+  for (int y = 0; y < dimy_; ++y) {
+    if (written_rows_[y]) {
+      std::fill_n(pixels_.begin() + y * dimx_, dimx_, blank);
+      written_rows_[y] = 0;
     }
   }
   cursor_.x = dimx_ - 1;
   cursor_.y = dimy_ - 1;
 
-  hyperlinks_ = {
-      "",
-  };
+  // Keep the allocated storage for the next frame.
+  hyperlinks_.resize(1);
+  hyperlink_ids_.clear();
+}
+
+/// @brief Change the dimensions of the screen, and fill it with space.
+///
+/// The pixels storage is reused when it is large enough. It is only
+/// reallocated when the number of cells exceeds the largest one seen so far.
+/// @see Reserve
+void Screen::Resize(int dimx, int dimy) {
+  dimx = std::max(dimx, 0);
+  dimy = std::max(dimy, 0);
+  stencil = {0, dimx - 1, 0, dimy - 1};
+  dimx_ = dimx;
+  dimy_ = dimy;
+  pixels_.assign(size_t(dimx) * size_t(dimy), Pixel());
+  written_rows_.assign(size_t(dimy), 0);
+  cursor_.x = dimx_ - 1;
+  cursor_.y = dimy_ - 1;
+  hyperlinks_.resize(1);
+  hyperlink_ids_.clear();
+}
+
+/// @brief Preallocate the storage for a screen of up to |dimx| x |dimy|
+/// cells, so that resizing it within these bounds doesn't allocate.
+/// @see Resize
+void Screen::Reserve(int dimx, int dimy) {
+  dimx = std::max(dimx, 0);
+  dimy = std::max(dimy, 0);
+  pixels_.reserve(size_t(dimx) * size_t(dimy));
+  written_rows_.reserve(size_t(dimy));
 }
 
 // clang-format off
@@ -536,19 +1286,19 @@ void Screen::ApplyShader() {
   for (int y = 0; y < dimy_; ++y) {
     for (int x = 0; x < dimx_; ++x) {
       // Box drawing character uses exactly 3 byte.
-      Pixel& cur = pixels_[y][x];
+      Pixel& cur = pixels_[y * dimx_ + x];
       if (!ShouldAttemptAutoMerge(cur)) {
         continue;
       }
 
       if (x > 0) {
-        Pixel& left = pixels_[y][x-1];
+        Pixel& left = pixels_[y * dimx_ + x - 1];
         if (ShouldAttemptAutoMerge(left)) {
           UpgradeLeftRight(left.character, cur.character);
         }
       }
       if (y > 0) {
-        Pixel& top = pixels_[y-1][x];
+        Pixel& top = pixels_[(y - 1) * dimx_ + x];
         if (ShouldAttemptAutoMerge(top)) {
           UpgradeTopDown(top.character, cur.character);
         }
@@ -558,20 +1308,25 @@ void Screen::ApplyShader() {
 }
 // clang-format on
 
-uint8_t Screen::RegisterHyperlink(const std::string& link) {
-  for (size_t i = 0; i < hyperlinks_.size(); ++i) {
-    if (hyperlinks_[i] == link) {
-      return i;
-    }
+uint16_t Screen::RegisterHyperlink(const std::string& link) {
+  if (link.empty()) {
+    return 0;
+  }
+  const auto it = hyperlink_ids_.find(link);
+  if (it != hyperlink_ids_.end()) {
+    return it->second;
   }
-  if (hyperlinks_.size() == std::numeric_limits<uint8_t>::max()) {
+  // Every id is used. The link is dropped.
+  if (hyperlinks_.size() > std::numeric_limits<uint16_t>::max()) {
     return 0;
   }
+  const auto id = uint16_t(hyperlinks_.size());
   hyperlinks_.push_back(link);
-  return hyperlinks_.size() - 1;
+  hyperlink_ids_.emplace(link, id);
+  return id;
 }
 
-const std::string& Screen::Hyperlink(uint8_t id) const {
+const std::string& Screen::Hyperlink(uint16_t id) const {
   if (id >= hyperlinks_.size()) {
     return hyperlinks_[0];
   }
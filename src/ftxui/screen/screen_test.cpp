@@ -0,0 +1,322 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <cstdint>  // for uint8_t
+#include <string>   // for allocator, string
+#include <tuple>    // for ignore
+#include <vector>   // for vector
+
+#include "ftxui/screen/color.hpp"     // for Color, Color::Red
+#include "ftxui/screen/screen.hpp"    // for Screen, Pixel
+#include "ftxui/screen/terminal.hpp"  // for SetColorSupport, Color, TrueColor
+
+namespace ftxui {
+
+TEST(ScreenTest, ToStringDiffIdentical) {
+  Screen previous(4, 3);
+  Screen screen(4, 3);
+  previous.at(1, 1) = "a";
+  screen.at(1, 1) = "a";
+  EXPECT_EQ(screen.ToStringDiff(previous), "\x1B[2B");
+}
+
+TEST(ScreenTest, ToStringDiffSingleCell) {
+  Screen previous(4, 3);
+  Screen screen(4, 3);
+  screen.at(2, 1) = "a";
+  EXPECT_EQ(screen.ToStringDiff(previous), "\x1B[1B\x1B[3Ga\x1B[1B\r");
+}
+
+TEST(ScreenTest, ToStringDiffRuns) {
+  Screen previous(6, 1);
+  Screen screen(6, 1);
+  screen.at(0, 0) = "a";
+  screen.at(1, 0) = "b";
+  screen.at(4, 0) = "c";
+  EXPECT_EQ(screen.ToStringDiff(previous), "ab\x1B[5Gc\r");
+}
+
+TEST(ScreenTest, ToStringDiffStyle) {
+  Screen previous(4, 1);
+  Screen screen(4, 1);
+  screen.PixelAt(1, 0).foreground_color = Color::Red;
+  EXPECT_EQ(screen.ToStringDiff(previous),
+            "\x1B[2G\x1B[31;49m \x1B[39;49m\r");
+}
+
+TEST(ScreenTest, ToStringDiffFullWidth) {
+  Screen previous(4, 1);
+  previous.at(0, 0) = "测";
+  previous.at(1, 0) = "";
+  Screen screen(4, 1);
+  screen.at(0, 0) = "测";
+  screen.at(1, 0) = "";
+  screen.at(2, 0) = "a";
+  EXPECT_EQ(screen.ToStringDiff(previous), "\x1B[3Ga\r");
+
+  // Replacing a fullwidth character by two narrow ones.
+  Screen next(4, 1);
+  next.at(0, 0) = " ";
+  next.at(1, 0) = "b";
+  next.at(2, 0) = "a";
+  EXPECT_EQ(next.ToStringDiff(screen), " b\r");
+
+  // Modifying the second half of a fullwidth character requires printing the
+  // character again.
+  Screen bold(4, 1);
+  bold.at(0, 0) = "测";
+  bold.at(1, 0) = "";
+  bold.at(2, 0) = "a";
+  bold.PixelAt(1, 0).bold = true;
+  EXPECT_EQ(bold.ToStringDiff(screen), "测\r");
+}
+
+TEST(ScreenTest, ToStringDiffHyperlink) {
+  Screen previous(2, 1);
+  previous.PixelAt(0, 0).hyperlink = previous.RegisterHyperlink("a.com");
+  Screen screen(2, 1);
+  screen.RegisterHyperlink("b.com");
+  screen.PixelAt(0, 0).hyperlink = screen.RegisterHyperlink("a.com");
+  EXPECT_EQ(screen.ToStringDiff(previous), "");
+}
+
+TEST(ScreenTest, ToStringDiffResized) {
+  Screen previous(2, 1);
+  Screen screen(3, 1);
+  screen.at(0, 0) = "a";
+  EXPECT_EQ(screen.ToStringDiff(previous), screen.ToString() + "\r");
+}
+
+TEST(ScreenTest, ToStringAppend) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  Screen screen(2, 1);
+  screen.at(0, 0) = "a";
+  screen.PixelAt(1, 0).bold = true;
+  screen.PixelAt(1, 0).underlined = true;
+  screen.PixelAt(1, 0).foreground_color = Color::RGB(1, 20, 255);
+  std::string out = "prefix";
+  screen.ToString(out);
+  EXPECT_EQ(out, "prefixa\x1B[1;4;38;2;1;20;255;49m \x1B[22;24;39;49m");
+  EXPECT_EQ(screen.ToString(), out.substr(6));
+}
+
+TEST(ScreenTest, ToStringRepeat) {
+  Screen screen(10, 2);
+  for (int x = 0; x < 10; ++x) {
+    screen.at(x, 0) = "─";
+  }
+  std::string out;
+  Screen::OutputOptions options;
+  options.repeat = true;
+  screen.ToString(out, options);
+  // The last cell of a line is never repeated.
+  EXPECT_EQ(out, "─\x1B[8b─\r\n \x1B[8b ");
+
+  // Short runs are printed as is.
+  out = "";
+  Screen small(4, 1);
+  small.ToString(out, options);
+  EXPECT_EQ(out, "    ");
+}
+
+TEST(ScreenTest, ToStringEraseLine) {
+  Screen screen(10, 2);
+  screen.at(0, 0) = "a";
+  screen.at(1, 0) = "b";
+  std::string out;
+  Screen::OutputOptions options;
+  options.erase_line = true;
+  screen.ToString(out, options);
+  // The last line is printed entirely.
+  EXPECT_EQ(out, "ab\x1B[K\r\n          ");
+}
+
+TEST(ScreenTest, ToStringDiffEraseLine) {
+  Screen previous(8, 2);
+  for (int x = 0; x < 8; ++x) {
+    previous.at(x, 0) = "a";
+  }
+  Screen screen(8, 2);
+  screen.at(0, 0) = "a";
+  screen.at(1, 0) = "a";
+  std::string out;
+  Screen::OutputOptions options;
+  options.erase_line = true;
+  screen.ToStringDiff(previous, out, options);
+  EXPECT_EQ(out, "\x1B[3G\x1B[K\x1B[1B\r");
+}
+
+TEST(ScreenTest, ToStringDiffScroll) {
+  Screen previous(3, 4);
+  Screen screen(3, 4);
+  for (int y = 0; y < 4; ++y) {
+    previous.at(0, y) = std::to_string(y);
+    screen.at(0, y) = std::to_string(y + 1);
+  }
+  std::string out;
+  Screen::OutputOptions options;
+  options.scroll_region = true;
+
+  // Scroll up, draw the exposed bottom line.
+  screen.ToStringDiff(previous, out, options);
+  EXPECT_EQ(out, "\x1B[1;4r\x1B[1S\x1B[r\x1B[3B4\r");
+
+  // Scroll down, draw the exposed top line.
+  out = "";
+  previous.ToStringDiff(screen, out, options);
+  EXPECT_EQ(out, "\x1B[1;4r\x1B[1T\x1B[r0\x1B[3B\r");
+
+  // Disabled:
+  EXPECT_EQ(screen.ToStringDiff(previous),
+            "1\x1B[1B\r2\x1B[1B\r3\x1B[1B\r4\r");
+}
+
+TEST(ScreenTest, ToStringThreads) {
+  Screen screen(10, 7);
+  for (int y = 0; y < 7; ++y) {
+    for (int x = 0; x < y; ++x) {
+      screen.at(x, y) = "─";
+      screen.PixelAt(x, y).bold = x % 2;
+      screen.PixelAt(x, y).foreground_color = Color::Palette16(y);
+    }
+  }
+  Screen::OutputOptions options;
+  options.repeat = true;
+  options.erase_line = true;
+  std::string serial;
+  screen.ToString(serial, options);
+
+  for (int threads : {2, 3, 7, 16}) {
+    options.threads = threads;
+    std::string parallel = "prefix";
+    screen.ToString(parallel, options);
+    EXPECT_EQ(parallel, "prefix" + serial);
+  }
+}
+
+TEST(ScreenTest, Row) {
+  Screen screen(3, 2);
+  screen.Row(1)[2].character = "a";
+  EXPECT_EQ(screen.at(2, 1), "a");
+  EXPECT_EQ(&screen.Row(1)[0], &screen.PixelAt(0, 1));
+  EXPECT_EQ(&screen.Row(0)[3], &screen.PixelAt(0, 1));
+}
+
+TEST(ScreenTest, WrittenRows) {
+  Screen screen(3, 3);
+  EXPECT_EQ(screen.WrittenRows(), std::vector<uint8_t>({0, 0, 0}));
+
+  screen.at(1, 1) = "a";
+  screen.Row(2);
+  EXPECT_EQ(screen.WrittenRows(), std::vector<uint8_t>({0, 1, 1}));
+
+  // Reading a const screen doesn't mark the rows.
+  const Screen& const_screen = screen;
+  std::ignore = const_screen.PixelAt(0, 0);
+  EXPECT_FALSE(screen.WrittenRows()[0]);
+
+  // Writing outside of the stencil doesn't mark the rows.
+  screen.stencil = {0, 2, 1, 2};
+  screen.PixelAt(0, 0).character = "b";
+  EXPECT_FALSE(screen.WrittenRows()[0]);
+
+  screen.Clear();
+  EXPECT_EQ(screen.WrittenRows(), std::vector<uint8_t>({0, 0, 0}));
+}
+
+TEST(ScreenTest, PixelCopy) {
+  Pixel pixel;
+  pixel.bold = true;
+  pixel.automerge = true;
+  pixel.hyperlink = 258;  // NOLINT
+  pixel.background_color = Color::Red;
+  pixel.foreground_color = Color::RGB(1, 2, 3);
+  pixel.character = "a⃒⃒";
+
+  auto expect_copy = [&](const Pixel& copy) {
+    EXPECT_TRUE(copy.bold);
+    EXPECT_FALSE(copy.dim);
+    EXPECT_TRUE(copy.automerge);
+    EXPECT_EQ(copy.hyperlink, 258);
+    EXPECT_EQ(copy.background_color, Color::Red);
+    EXPECT_EQ(copy.foreground_color, Color::RGB(1, 2, 3));
+    EXPECT_EQ(copy.character, "a⃒⃒");
+  };
+
+  const Pixel copy(pixel);  // NOLINT
+  expect_copy(copy);
+
+  Pixel assigned;
+  assigned.dim = true;
+  assigned = pixel;
+  expect_copy(assigned);
+
+  Pixel& self = assigned;
+  assigned = self;
+  expect_copy(assigned);
+}
+
+TEST(ScreenTest, Clear) {
+  Screen screen(3, 2);
+  screen.PixelAt(1, 1).character = "a";
+  screen.PixelAt(1, 1).bold = true;
+  screen.PixelAt(2, 1).hyperlink = screen.RegisterHyperlink("link");
+  screen.Clear();
+
+  EXPECT_EQ(screen.ToString(), "   \r\n   ");
+  EXPECT_EQ(screen.RegisterHyperlink("other"), 1);
+  EXPECT_EQ(screen.Hyperlink(1), "other");
+}
+
+TEST(ScreenTest, Resize) {
+  Screen screen(4, 2);
+  screen.at(3, 1) = "a";
+  screen.Resize(2, 3);
+  EXPECT_EQ(screen.dimx(), 2);
+  EXPECT_EQ(screen.dimy(), 3);
+  EXPECT_EQ(screen.stencil.x_max, 1);
+  EXPECT_EQ(screen.stencil.y_max, 2);
+  EXPECT_EQ(screen.ToString(), "  \r\n  \r\n  ");
+  EXPECT_EQ(screen.WrittenRows(), std::vector<uint8_t>({0, 0, 0}));
+
+  screen.Reserve(10, 10);
+  screen.Resize(5, 1);
+  screen.at(4, 0) = "b";
+  EXPECT_EQ(screen.ToString(), "    b");
+}
+
+TEST(ScreenTest, RegisterHyperlink) {
+  Screen screen(1, 1);
+  EXPECT_EQ(screen.RegisterHyperlink(""), 0);
+  for (int i = 1; i <= 1000; ++i) {
+    EXPECT_EQ(screen.RegisterHyperlink("https://" + std::to_string(i)), i);
+  }
+  EXPECT_EQ(screen.RegisterHyperlink("https://300"), 300);
+  EXPECT_EQ(screen.Hyperlink(300), "https://300");
+  EXPECT_EQ(screen.Hyperlink(1001), "");
+}
+
+TEST(ScreenTest, ToStringDiffWrittenRows) {
+  Screen previous(3, 3);
+  previous.at(0, 0) = "a";
+  Screen screen(3, 3);
+  screen.at(0, 2) = "b";
+
+  // The blank rows are skipped. The others are compared.
+  EXPECT_EQ(screen.ToStringDiff(previous), " \x1B[2B\rb\r");
+  EXPECT_EQ(screen.ToStringDiff(screen), "\x1B[2B");
+}
+
+TEST(ScreenTest, ToStringDiffHyperlinks) {
+  Screen previous(2, 1);
+  previous.PixelAt(0, 0).hyperlink = previous.RegisterHyperlink("a");
+  Screen screen(2, 1);
+  screen.PixelAt(0, 0).hyperlink = screen.RegisterHyperlink("b");
+
+  // The pixels are identical, but the hyperlinks they designate differ.
+  EXPECT_EQ(screen.ToStringDiff(previous),
+            "\x1B]8;;b\x1B\\ \x1B]8;;\x1B\\\r");
+}
+
+}  // namespace ftxui
@@ -11,11 +11,20 @@
 
 #include "ftxui/screen/string.hpp"
 
-#include <array>    // for array
-#include <cstddef>  // for size_t
-#include <cstdint>  // for uint32_t, uint8_t, uint16_t, int32_t
-#include <string>   // for string, basic_string, wstring
-#include <tuple>    // for _Swallow_assign, ignore
+#include <algorithm>    // for max, min
+#include <array>        // for array
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint8_t, uint16_t, int32_t, uint64_t
+#include <cstring>      // for memcpy
+#include <string>       // for string, basic_string, wstring
+#include <string_view>  // for string_view
+#include <tuple>        // for ignore
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>  // for _mm_loadu_si128, _mm_cmpgt_epi8, ...
+#define FTXUI_STRING_SSE2
+#endif
 
 #include "ftxui/screen/deprecated.hpp"       // for wchar_width, wstring_width
 #include "ftxui/screen/string_internal.hpp"  // for WordBreakProperty, EatCodePoint, CodepointToWordBreakProperty, GlyphCount, GlyphIterate, GlyphNext, GlyphPrevious, IsCombining, IsControl, IsFullWidth, Utf8ToWordBreakProperty
@@ -1075,6 +1084,104 @@ constexpr std::array<WordBreakPropertyInterval, 993> g_word_break_intervals = {{
     {0xE0100, 0xE01EF, WBP::Extend},
 }};
 
+// The properties of every codepoint, compiled from the interval tables above
+// into a two-stage lookup table. The codepoints are split into pages of 256.
+// Most of the pages have the same properties for all of their codepoints, and
+// are stored directly in the first stage. The others point to a leaf of the
+// second stage, storing one byte per codepoint.
+//
+// Each byte is the WordBreakProperty, plus the |kFullWidth| bit.
+constexpr uint8_t kFullWidth = 0x20;
+constexpr uint32_t kPageBits = 8;
+constexpr uint32_t kPageSize = 1 << kPageBits;
+constexpr uint32_t kPageCount = 0x110000 >> kPageBits;
+constexpr uint16_t kUniformPage = 0x8000;
+
+// Whether the properties may change inside each page. This is the case when
+// an interval starts or ends in the middle of it.
+constexpr std::array<bool, kPageCount> g_mixed_pages{[]() constexpr {
+  std::array<bool, kPageCount> mixed{};
+  auto mark = [&](uint32_t first, uint32_t last) constexpr {
+    if (first % kPageSize != 0) {
+      mixed[first >> kPageBits] = true;  // NOLINT
+    }
+    if ((last + 1) % kPageSize != 0) {
+      mixed[last >> kPageBits] = true;  // NOLINT
+    }
+  };
+  for (auto interval : g_word_break_intervals) {
+    mark(interval.first, interval.last);
+  }
+  for (auto interval : g_full_width_characters) {
+    mark(interval.first, interval.last);
+  }
+  return mixed;
+}()};
+
+constexpr size_t g_mixed_page_count{[]() constexpr {
+  size_t count = 0;
+  for (bool mixed : g_mixed_pages) {
+    count += mixed ? 1 : 0;
+  }
+  return count;
+}()};
+
+struct PropertyTable {
+  std::array<uint16_t, kPageCount> pages;
+  std::array<uint8_t, g_mixed_page_count * kPageSize> leaves;
+};
+
+// Visit the pages covered by the intervals. The uniform ones are covered
+// entirely, so their value is set at once. Only the mixed ones are filled
+// codepoint by codepoint.
+constexpr PropertyTable g_properties{[]() constexpr {
+  PropertyTable table{};
+  uint16_t leaf = 0;
+  for (uint32_t page = 0; page < kPageCount; ++page) {
+    table.pages[page] = g_mixed_pages[page]  // NOLINT
+                            ? leaf++
+                            : uint16_t(kUniformPage | uint8_t(WBP::ALetter));
+  }
+
+  auto apply = [&](uint32_t first, uint32_t last, uint8_t property,
+                   uint8_t mask) constexpr {
+    for (uint32_t page = first >> kPageBits; page <= last >> kPageBits;
+         ++page) {
+      uint16_t& entry = table.pages[page];  // NOLINT
+      if (entry & kUniformPage) {
+        entry = uint16_t((entry & ~mask) | property);
+        continue;
+      }
+      const uint32_t begin = std::max(first, page << kPageBits);
+      const uint32_t end = std::min(last, ((page + 1) << kPageBits) - 1);
+      for (uint32_t ucs = begin; ucs <= end; ++ucs) {
+        uint8_t& value =
+            table.leaves[entry * kPageSize + ucs % kPageSize];  // NOLINT
+        value = uint8_t((value & ~mask) | property);
+      }
+    }
+  };
+  for (auto interval : g_word_break_intervals) {
+    apply(interval.first, interval.last, uint8_t(interval.property),
+          kFullWidth - 1);
+  }
+  for (auto interval : g_full_width_characters) {
+    apply(interval.first, interval.last, kFullWidth, kFullWidth);
+  }
+  return table;
+}()};
+
+uint8_t CodepointProperties(uint32_t ucs) {
+  if (ucs >= 0x110000) {  // NOLINT
+    return uint8_t(WBP::ALetter);
+  }
+  const uint16_t entry = g_properties.pages[ucs >> kPageBits];  // NOLINT
+  if (entry & kUniformPage) {
+    return uint8_t(entry);
+  }
+  return g_properties.leaves[entry * kPageSize + ucs % kPageSize];  // NOLINT
+}
+
 // Construct table of just WBP::Extend character intervals
 constexpr auto g_extend_characters{[]() constexpr {
   // Compute number of extend character intervals
@@ -1146,31 +1253,92 @@ bool Bisearch(uint32_t ucs, const std::array<C, N>& table, C* out) {
   return false;
 }
 
-int codepoint_width(uint32_t ucs) {
-  if (ftxui::IsControl(ucs)) {
-    return -1;
-  }
+// Printable ASCII characters are one cell wide glyphs on their own. This
+// excludes the control characters, and the line feed.
+bool IsPrintableAscii(char c) {
+  return c >= 0x20 && c < 0x7F;  // NOLINT
+}
+
+}  // namespace
+
+namespace ftxui {
 
-  if (ftxui::IsCombining(ucs)) {
+size_t PrintableAsciiRunSwar(std::string_view input, size_t start) {
+  const char* data = input.data();
+  const size_t size = input.size();
+  size_t i = start;
+  if (i >= size || !IsPrintableAscii(data[i])) {
     return 0;
   }
 
-  if (ftxui::IsFullWidth(ucs)) {
-    return 2;
+  constexpr uint64_t ones = 0x0101010101010101ULL;   // NOLINT
+  constexpr uint64_t highs = 0x8080808080808080ULL;  // NOLINT
+  while (i + 8 <= size) {
+    uint64_t bytes = 0;
+    std::memcpy(&bytes, data + i, sizeof(bytes));
+    const uint64_t non_ascii = bytes & highs;
+    const uint64_t below_space = (bytes - ones * 0x20) & ~bytes & highs;
+    const uint64_t del_bytes = bytes ^ (ones * 0x7F);
+    const uint64_t del = (del_bytes - ones) & ~del_bytes & highs;
+    if (non_ascii | below_space | del) {
+      break;
+    }
+    i += 8;  // NOLINT
   }
 
-  return 1;
+  while (i < size && IsPrintableAscii(data[i])) {
+    ++i;
+  }
+  return i - start;
 }
 
-}  // namespace
+size_t PrintableAsciiRunSse2(std::string_view input, size_t start) {
+#if defined(FTXUI_STRING_SSE2)
+  const char* data = input.data();
+  const size_t size = input.size();
+  size_t i = start;
+  if (i >= size || !IsPrintableAscii(data[i])) {
+    return 0;
+  }
 
-namespace ftxui {
+  // Bytes >= 0x80 are negative, and fail the first comparison.
+  const __m128i lower = _mm_set1_epi8(0x1F);  // NOLINT
+  const __m128i upper = _mm_set1_epi8(0x7F);  // NOLINT
+  while (i + 16 <= size) {
+    const __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));  // NOLINT
+    const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(bytes, lower),
+                                            _mm_cmplt_epi8(bytes, upper));
+    if (_mm_movemask_epi8(printable) != 0xFFFF) {  // NOLINT
+      break;
+    }
+    i += 16;  // NOLINT
+  }
+
+  while (i < size && IsPrintableAscii(data[i])) {
+    ++i;
+  }
+  return i - start;
+#else
+  return PrintableAsciiRunSwar(input, start);
+#endif
+}
+
+// Most of the text is ASCII. This skips the UTF-8 decoding and the Unicode
+// tables for them, by checking 16 or 8 bytes at once.
+size_t PrintableAsciiRun(std::string_view input, size_t start) {
+#if defined(FTXUI_STRING_SSE2)
+  return PrintableAsciiRunSse2(input, start);
+#else
+  return PrintableAsciiRunSwar(input, start);
+#endif
+}
 
 // From UTF8 encoded string |input|, eat in between 1 and 4 byte representing
 // one codepoint. Put the codepoint into |ucs|. Start at |start| and update
 // |end| to represent the beginning of the next byte to eat for consecutive
 // executions.
-bool EatCodePoint(const std::string& input,
+bool EatCodePoint(std::string_view input,
                   size_t start,
                   size_t* end,
                   uint32_t* ucs) {
@@ -1279,14 +1447,15 @@ bool EatCodePoint(const std::wstring& input,
 }
 
 bool IsCombining(uint32_t ucs) {
-  return Bisearch(ucs, g_extend_characters);
+  return (CodepointProperties(ucs) & (kFullWidth - 1)) ==
+         uint8_t(WBP::Extend);
 }
 
 bool IsFullWidth(uint32_t ucs) {
   if (ucs < 0x0300)  // Quick path: // NOLINT
     return false;
 
-  return Bisearch(ucs, g_full_width_characters);
+  return CodepointProperties(ucs) & kFullWidth;
 }
 
 bool IsControl(uint32_t ucs) {
@@ -1304,11 +1473,39 @@ bool IsControl(uint32_t ucs) {
 }
 
 WordBreakProperty CodepointToWordBreakProperty(uint32_t codepoint) {
+  return WordBreakProperty(CodepointProperties(codepoint) & (kFullWidth - 1));
+}
+
+bool IsCombiningReference(uint32_t ucs) {
+  return Bisearch(ucs, g_extend_characters);
+}
+
+bool IsFullWidthReference(uint32_t ucs) {
+  return Bisearch(ucs, g_full_width_characters);
+}
+
+WordBreakProperty CodepointToWordBreakPropertyReference(uint32_t codepoint) {
   WordBreakPropertyInterval interval = {0, 0, WBP::ALetter};
   std::ignore = Bisearch(codepoint, g_word_break_intervals, &interval);
   return interval.property;
 }
 
+int codepoint_width(uint32_t ucs) {
+  if (IsControl(ucs)) {
+    return -1;
+  }
+
+  if (IsCombining(ucs)) {
+    return 0;
+  }
+
+  if (IsFullWidth(ucs)) {
+    return 2;
+  }
+
+  return 1;
+}
+
 int wchar_width(wchar_t ucs) {
   return codepoint_width(uint32_t(ucs));
 }
@@ -1330,6 +1527,13 @@ int string_width(const std::string& input) {
   int width = 0;
   size_t start = 0;
   while (start < input.size()) {
+    const size_t ascii = PrintableAsciiRun(input, start);
+    width += static_cast<int>(ascii);
+    start += ascii;
+    if (start >= input.size()) {
+      break;
+    }
+
     uint32_t codepoint = 0;
     if (!EatCodePoint(input, start, &start, &codepoint)) {
       continue;
@@ -1355,11 +1559,19 @@ int string_width(const std::string& input) {
 
 std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
   std::vector<std::string> out;
-  const std::string current;
   out.reserve(input.size());
   size_t start = 0;
   size_t end = 0;
   while (start < input.size()) {
+    const size_t ascii = PrintableAsciiRun(input, start);
+    for (size_t i = start; i < start + ascii; ++i) {
+      out.emplace_back(1, input[i]);
+    }
+    start += ascii;
+    if (start >= input.size()) {
+      break;
+    }
+
     uint32_t codepoint = 0;
     if (!EatCodePoint(input, start, &end, &codepoint)) {
       start = end;
@@ -1375,6 +1587,7 @@ std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
     }
 
     // Combining characters are put with the previous glyph they are modifying.
+    // After a fullwidth glyph, this is its empty second cell.
     if (IsCombining(codepoint)) {
       if (!out.empty()) {
         out.back() += append;
@@ -1396,6 +1609,115 @@ std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
   return out;
 }
 
+GlyphRange::iterator::iterator(std::string_view input, size_t start)
+    : input_(input), next_(start) {
+  Next();
+}
+
+GlyphRange::iterator& GlyphRange::iterator::operator=(const iterator& other) {
+  if (this == &other) {
+    return *this;
+  }
+  input_ = other.input_;
+  start_ = other.start_;
+  next_ = other.next_;
+  fullwidth_ = other.fullwidth_;
+  glyph_ = other.glyph_;
+  composed_ = other.composed_;
+
+  // The composed text belongs to the iterator.
+  if (!glyph_.text.empty() && glyph_.text.data() == other.composed_.data()) {
+    glyph_.text = composed_;
+  }
+  return *this;
+}
+
+void GlyphRange::iterator::Next() {
+  size_t start = next_;
+
+  // Fullwidth characters take two cells. The second one contains the combining
+  // characters following the first one, if any.
+  if (fullwidth_) {
+    fullwidth_ = false;
+    start_ = start;
+    glyph_ = {input_.substr(start, 0), 0};
+    Combine(start);
+    return;
+  }
+
+  const size_t size = input_.size();
+  while (start < size) {
+    // Quick path: A printable ASCII character, not followed by combining
+    // characters.
+    if (IsPrintableAscii(input_[start]) &&
+        (start + 1 == size || IsPrintableAscii(input_[start + 1]))) {
+      start_ = start;
+      glyph_ = {input_.substr(start, 1), 1};
+      next_ = start + 1;
+      return;
+    }
+
+    size_t end = 0;
+    uint32_t codepoint = 0;
+    const bool eaten = EatCodePoint(input_, start, &end, &codepoint);
+
+    // Ignore invalid and control characters, and the combining characters not
+    // following a glyph.
+    if (!eaten || IsControl(codepoint) || IsCombining(codepoint)) {
+      start = end;
+      continue;
+    }
+
+    start_ = start;
+    if (IsFullWidth(codepoint)) {
+      glyph_ = {input_.substr(start, end - start), 2};
+      next_ = end;
+      fullwidth_ = true;
+      return;
+    }
+
+    glyph_ = {input_.substr(start, end - start), 1};
+    Combine(end);
+    return;
+  }
+
+  start_ = std::string_view::npos;
+  next_ = size;
+  glyph_ = {};
+}
+
+// Append the combining characters following |start| to the current cell. Like
+// in Utf8ToGlyphs(), the invalid and control characters in between are ignored.
+void GlyphRange::iterator::Combine(size_t start) {
+  const size_t size = input_.size();
+  while (start < size) {
+    size_t end = 0;
+    uint32_t codepoint = 0;
+    const bool eaten = EatCodePoint(input_, start, &end, &codepoint);
+    if (eaten && !IsControl(codepoint)) {
+      if (!IsCombining(codepoint)) {
+        break;
+      }
+      const std::string_view mark = input_.substr(start, end - start);
+      const std::string_view text = glyph_.text;
+      if (text.empty()) {
+        glyph_.text = mark;
+      } else if (text.data() + text.size() == mark.data()) {
+        glyph_.text = {text.data(), text.size() + mark.size()};
+      } else {
+        // The mark is separated from the glyph. Copy them together.
+        if (text.data() != composed_.data()) {
+          composed_ = text;
+        }
+        composed_ += mark;
+        glyph_.text = composed_;
+      }
+    }
+    start = end;
+  }
+  next_ = start;
+}
+
 size_t GlyphPrevious(const std::string& input, size_t start) {
   while (true) {
     if (start == 0) {
@@ -1468,6 +1790,15 @@ std::vector<int> CellToGlyphIndex(const std::string& input) {
   size_t start = 0;
   size_t end = 0;
   while (start < input.size()) {
+    const size_t ascii = PrintableAsciiRun(input, start);
+    for (size_t i = 0; i < ascii; ++i) {
+      out.push_back(++x);
+    }
+    start += ascii;
+    if (start >= input.size()) {
+      break;
+    }
+
     uint32_t codepoint = 0;
     const bool eaten = EatCodePoint(input, start, &end, &codepoint);
     start = end;
@@ -1507,6 +1838,13 @@ int GlyphCount(const std::string& input) {
   size_t start = 0;
   size_t end = 0;
   while (start < input.size()) {
+    const size_t ascii = PrintableAsciiRun(input, start);
+    size += static_cast<int>(ascii);
+    start += ascii;
+    if (start >= input.size()) {
+      break;
+    }
+
     uint32_t codepoint = 0;
     const bool eaten = EatCodePoint(input, start, &end, &codepoint);
     start = end;
@@ -1554,9 +1892,7 @@ std::vector<WordBreakProperty> Utf8ToWordBreakProperty(
       continue;
     }
 
-    WordBreakPropertyInterval interval = {0, 0, WBP::ALetter};
-    std::ignore = Bisearch(codepoint, g_word_break_intervals, &interval);
-    out.push_back(interval.property);
+    out.push_back(CodepointToWordBreakProperty(codepoint));
   }
   return out;
 }
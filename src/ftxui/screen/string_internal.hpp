@@ -5,10 +5,11 @@
 #define FTXUI_SCREEN_STRING_INTERNAL_HPP
 
 #include <cstdint>
+#include <string_view>
 
 namespace ftxui {
 
-bool EatCodePoint(const std::string& input,
+bool EatCodePoint(std::string_view input,
                   size_t start,
                   size_t* end,
                   uint32_t* ucs);
@@ -21,6 +22,9 @@ bool IsCombining(uint32_t ucs);
 bool IsFullWidth(uint32_t ucs);
 bool IsControl(uint32_t ucs);
 
+// The width of a codepoint in cells. -1 for control characters.
+int codepoint_width(uint32_t ucs);
+
 size_t GlyphPrevious(const std::string& input, size_t start);
 size_t GlyphNext(const std::string& input, size_t start);
 
@@ -33,6 +37,14 @@ size_t GlyphIterate(const std::string& input,
 // Returns the number of glyphs in |input|.
 int GlyphCount(const std::string& input);
 
+// Returns the number of printable ASCII characters in |input|, starting at
+// |start|. They are one cell wide glyphs on their own. The SWAR version checks
+// 8 bytes at once, and the SSE2 version 16 bytes at once. Without SSE2, the
+// latter is the same as the former. PrintableAsciiRun uses the fastest one.
+size_t PrintableAsciiRun(std::string_view input, size_t start);
+size_t PrintableAsciiRunSwar(std::string_view input, size_t start);
+size_t PrintableAsciiRunSse2(std::string_view input, size_t start);
+
 // Properties from:
 // https://www.unicode.org/Public/UCD/latest/ucd/auxiliary/WordBreakProperty.txt
 enum class WordBreakProperty : int8_t {
@@ -56,6 +68,13 @@ enum class WordBreakProperty : int8_t {
   ZWJ,
 };
 WordBreakProperty CodepointToWordBreakProperty(uint32_t codepoint);
+
+// The same properties, found by a binary search into the Unicode intervals
+// instead of the lookup table. Only used by the tests and the benchmarks, as a
+// reference.
+bool IsCombiningReference(uint32_t ucs);
+bool IsFullWidthReference(uint32_t ucs);
+WordBreakProperty CodepointToWordBreakPropertyReference(uint32_t codepoint);
 std::vector<WordBreakProperty> Utf8ToWordBreakProperty(
     const std::string& input);
 
@@ -3,11 +3,140 @@
 // the LICENSE file.
 #include "ftxui/screen/string.hpp"
 #include <gtest/gtest.h>
-#include <string>  // for allocator, string
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
+#include <iterator>  // for size
+#include <random>   // for mt19937, uniform_int_distribution
+#include <string>   // for allocator, string
+#include <utility>  // for pair
+#include <vector>   // for vector
 #include "ftxui/screen/string_internal.hpp"
 
 namespace ftxui {
 
+namespace {
+
+// Random text, mixing long ASCII runs with everything interrupting them.
+std::string RandomText(std::mt19937& random) {
+  const std::string pieces[] = {
+      "a",    " ",     "~",   "\x7F",         "\1",  "\n",
+      "\t",   "测",    "🪐",  "\xE2\x83\x92",  "é",   "\xFF",
+      "\xE2", "\x80", "ā",   "\xF0\x9F",     std::string("\0", 1),
+  };
+  std::uniform_int_distribution<int> piece(0, std::size(pieces) - 1);
+  std::uniform_int_distribution<int> length(0, 40);
+  std::uniform_int_distribution<int> ascii(0x20, 0x7E);
+  std::string out;
+  const int count = length(random);
+  for (int i = 0; i < count; ++i) {
+    if (random() % 2) {
+      const int run = length(random);
+      for (int j = 0; j < run; ++j) {
+        out += char(ascii(random));
+      }
+    } else {
+      out += pieces[piece(random)];
+    }
+  }
+  return out;
+}
+
+// The scalar versions, decoding every codepoint.
+size_t ReferenceAsciiRun(const std::string& input, size_t start) {
+  size_t i = start;
+  while (i < input.size() && input[i] >= 0x20 && input[i] < 0x7F) {
+    ++i;
+  }
+  return i - start;
+}
+
+int ReferenceStringWidth(const std::string& input) {
+  int width = 0;
+  size_t start = 0;
+  while (start < input.size()) {
+    uint32_t codepoint = 0;
+    if (!EatCodePoint(input, start, &start, &codepoint) ||
+        IsControl(codepoint) || IsCombining(codepoint)) {
+      continue;
+    }
+    width += IsFullWidth(codepoint) ? 2 : 1;
+  }
+  return width;
+}
+
+// Combining characters modify the last cell, if any.
+std::vector<std::string> ReferenceUtf8ToGlyphs(const std::string& input) {
+  std::vector<std::string> out;
+  size_t start = 0;
+  size_t end = 0;
+  while (start < input.size()) {
+    uint32_t codepoint = 0;
+    const bool eaten = EatCodePoint(input, start, &end, &codepoint);
+    const std::string append = input.substr(start, end - start);
+    start = end;
+    if (!eaten || IsControl(codepoint)) {
+      continue;
+    }
+    if (IsCombining(codepoint)) {
+      if (!out.empty()) {
+        out.back() += append;
+      }
+      continue;
+    }
+    out.push_back(append);
+    if (IsFullWidth(codepoint)) {
+      out.emplace_back("");
+    }
+  }
+  return out;
+}
+
+int ReferenceGlyphCount(const std::string& input) {
+  int size = 0;
+  size_t start = 0;
+  size_t end = 0;
+  while (start < input.size()) {
+    uint32_t codepoint = 0;
+    const bool eaten = EatCodePoint(input, start, &end, &codepoint);
+    start = end;
+    if (!eaten || IsControl(codepoint)) {
+      continue;
+    }
+    if (!IsCombining(codepoint) || size == 0) {
+      size++;
+    }
+  }
+  return size;
+}
+
+std::vector<int> ReferenceCellToGlyphIndex(const std::string& input) {
+  int x = -1;
+  std::vector<int> out;
+  size_t start = 0;
+  size_t end = 0;
+  while (start < input.size()) {
+    uint32_t codepoint = 0;
+    const bool eaten = EatCodePoint(input, start, &end, &codepoint);
+    start = end;
+    if (!eaten || IsControl(codepoint)) {
+      continue;
+    }
+    if (IsCombining(codepoint)) {
+      if (x == -1) {
+        out.push_back(++x);
+      }
+      continue;
+    }
+    out.push_back(++x);
+    if (IsFullWidth(codepoint)) {
+      out.push_back(x);
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
 TEST(StringTest, StringWidth) {
   // Basic:
   EXPECT_EQ(0, string_width(""));
@@ -30,6 +159,54 @@ TEST(StringTest, StringWidth) {
   EXPECT_EQ(2, string_width("a\1a"));
 }
 
+TEST(StringTest, AsciiRuns) {
+  // Long runs of ASCII characters, interrupted by other characters.
+  const std::string ascii = "abcdefghijklmnopqrstuvwxyz0123456789";
+  EXPECT_EQ(36, string_width(ascii));
+  EXPECT_EQ(36, GlyphCount(ascii));
+  EXPECT_EQ(37, string_width(ascii + "\n"));
+  EXPECT_EQ(72, string_width(ascii + "\x7F" + ascii));
+  EXPECT_EQ(72, string_width(ascii + "\1" + ascii));
+  EXPECT_EQ(74, string_width(ascii + "测" + ascii));
+  EXPECT_EQ(72, string_width(ascii + "\xE2\x83\x92" + ascii));
+
+  // A combining character modifies the last character of the run.
+  const auto glyphs = Utf8ToGlyphs(ascii + "\xE2\x83\x92" + ascii);
+  EXPECT_EQ(glyphs.size(), 72u);
+  EXPECT_EQ(glyphs[35], "9\xE2\x83\x92");
+  EXPECT_EQ(glyphs[36], "a");
+  EXPECT_EQ(GlyphCount(ascii + "\xE2\x83\x92" + ascii), 72);
+
+  const auto cells = CellToGlyphIndex(ascii + "测" + ascii);
+  EXPECT_EQ(cells.size(), 74u);
+  EXPECT_EQ(cells[35], 35);
+  EXPECT_EQ(cells[36], 36);
+  EXPECT_EQ(cells[37], 36);
+  EXPECT_EQ(cells[38], 37);
+}
+
+TEST(StringTest, AsciiRunsRandom) {
+  std::mt19937 random(42);  // NOLINT
+  for (int i = 0; i < 2000; ++i) {
+    const std::string text = RandomText(random);
+    for (size_t start = 0; start <= text.size(); ++start) {
+      const size_t run = ReferenceAsciiRun(text, start);
+      ASSERT_EQ(PrintableAsciiRun(text, start), run) << text << " " << start;
+      ASSERT_EQ(PrintableAsciiRunSwar(text, start), run) << text;
+      ASSERT_EQ(PrintableAsciiRunSse2(text, start), run) << text;
+    }
+    ASSERT_EQ(string_width(text), ReferenceStringWidth(text)) << text;
+    ASSERT_EQ(Utf8ToGlyphs(text), ReferenceUtf8ToGlyphs(text)) << text;
+    std::vector<std::string> glyphs;
+    for (const GlyphView& glyph : Utf8Glyphs(text)) {
+      glyphs.emplace_back(glyph.text);
+    }
+    ASSERT_EQ(glyphs, Utf8ToGlyphs(text)) << text;
+    ASSERT_EQ(GlyphCount(text), ReferenceGlyphCount(text)) << text;
+    ASSERT_EQ(CellToGlyphIndex(text), ReferenceCellToGlyphIndex(text)) << text;
+  }
+}
+
 TEST(StringTest, Utf8ToGlyphs) {
   using T = std::vector<std::string>;
   // Basic:
@@ -43,9 +220,44 @@ TEST(StringTest, Utf8ToGlyphs) {
   EXPECT_EQ(Utf8ToGlyphs("ā"), T({"ā"}));
   EXPECT_EQ(Utf8ToGlyphs("a⃒"), T({"a⃒"}));
   EXPECT_EQ(Utf8ToGlyphs("a̗"), T({"a̗"}));
+  EXPECT_EQ(Utf8ToGlyphs("测̗"), T({"测", "̗"}));
   // Control characters:
   EXPECT_EQ(Utf8ToGlyphs("\1"), T({}));
   EXPECT_EQ(Utf8ToGlyphs("a\1a"), T({"a", "a"}));
+  EXPECT_EQ(Utf8ToGlyphs("a\1̗"), T({"a̗"}));
+}
+
+TEST(StringTest, Utf8Glyphs) {
+  using T = std::vector<std::pair<std::string, int>>;
+  auto glyphs = [](const std::string& input) {
+    T out;
+    for (const GlyphView& glyph : Utf8Glyphs(input)) {
+      out.emplace_back(glyph.text, glyph.width);
+    }
+    return out;
+  };
+  EXPECT_EQ(glyphs(""), T({}));
+  EXPECT_EQ(glyphs("ab"), T({{"a", 1}, {"b", 1}}));
+  EXPECT_EQ(glyphs("测试"), T({{"测", 2}, {"", 0}, {"试", 2}, {"", 0}}));
+  EXPECT_EQ(glyphs("a⃒b"), T({{"a⃒", 1}, {"b", 1}}));
+  EXPECT_EQ(glyphs("测̗"), T({{"测", 2}, {"̗", 0}}));
+  EXPECT_EQ(glyphs("\1a\1\n"), T({{"a", 1}, {"\n", 1}}));
+  EXPECT_EQ(glyphs("̗a"), T({{"a", 1}}));
+  EXPECT_EQ(glyphs("a\1̗b"), T({{"a̗", 1}, {"b", 1}}));
+  EXPECT_EQ(glyphs("测\1̗\1̗"), T({{"测", 2}, {"̗̗", 0}}));
+
+  // The glyphs are views into the input.
+  const std::string input = "abc";
+  EXPECT_EQ(Utf8Glyphs(input).begin()->text.data(), input.data());
+
+  // Except the ones separated from their combining characters. They belong to
+  // the iterator.
+  const std::string separated = "a\1̗b\1̗";
+  auto it = Utf8Glyphs(separated).begin();
+  const auto copy = it;
+  ++it;
+  EXPECT_EQ(copy->text, "a̗");
+  EXPECT_EQ(it->text, "b̗");
 }
 
 TEST(StringTest, GlyphCount) {
@@ -142,6 +354,31 @@ TEST(StringTest, Utf8ToWordBreakProperty) {
   EXPECT_EQ(Utf8ToWordBreakProperty("\n"), T({P::LF}));
 }
 
+TEST(StringTest, CodepointProperties) {
+  // Compare the lookup table against the binary search into the Unicode
+  // intervals, for every codepoint, and a few values outside of the range.
+  std::vector<uint32_t> codepoints;
+  for (uint32_t ucs = 0; ucs <= 0x10FFFF; ++ucs) {
+    codepoints.push_back(ucs);
+  }
+  for (uint32_t ucs : {0x110000u, 0x110100u, 0x1FFFFFu, 0x7FFFFFFFu,
+                       0xFFFFFFFFu}) {
+    codepoints.push_back(ucs);
+  }
+
+  for (uint32_t ucs : codepoints) {
+    const bool combining = IsCombiningReference(ucs);
+    const bool full_width = IsFullWidthReference(ucs);
+    const int width = IsControl(ucs) ? -1 : combining ? 0 : full_width ? 2 : 1;
+    ASSERT_EQ(IsCombining(ucs), combining) << ucs;
+    ASSERT_EQ(IsFullWidth(ucs), full_width) << ucs;
+    ASSERT_EQ(CodepointToWordBreakProperty(ucs),
+              CodepointToWordBreakPropertyReference(ucs))
+        << ucs;
+    ASSERT_EQ(codepoint_width(ucs), width) << ucs;
+  }
+}
+
 TEST(StringTest, to_string) {
   EXPECT_EQ(to_string(L"hello"), "hello");
   EXPECT_EQ(to_string(L"€"), "€");
@@ -1,8 +1,10 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <cstdlib>  // for getenv
-#include <string>   // for string, allocator
+#include <cstdlib>     // for getenv
+#include <functional>  // for function
+#include <string>      // for string, allocator
+#include <utility>     // for move
 
 #include "ftxui/screen/terminal.hpp"
 
@@ -26,6 +28,15 @@ namespace {
 bool g_cached = false;                     // NOLINT
 Terminal::Color g_cached_supported_color;  // NOLINT
 
+bool g_size_caching = false;  // NOLINT
+bool g_size_cached = false;   // NOLINT
+Dimensions g_cached_size;     // NOLINT
+
+std::function<Dimensions()>& SizeProvider() {
+  static std::function<Dimensions()> g_size_provider;
+  return g_size_provider;
+}
+
 Dimensions& FallbackSize() {
 #if defined(__EMSCRIPTEN__)
   // This dimension was chosen arbitrarily to be able to display:
@@ -84,14 +95,10 @@ Terminal::Color ComputeColorSupport() {
   return Terminal::Color::Palette16;
 }
 
-}  // namespace
-
-namespace Terminal {
-
-/// @brief Get the terminal size.
-/// @return The terminal size.
-/// @ingroup screen
-Dimensions Size() {
+Dimensions ComputeSize() {
+  if (SizeProvider()) {
+    return SizeProvider()();
+  }
 #if defined(__EMSCRIPTEN__)
   // This dimension was chosen arbitrarily to be able to display:
   // https://arthursonzogni.com/FTXUI/examples
@@ -119,10 +126,56 @@ Dimensions Size() {
 #endif
 }
 
+}  // namespace
+
+namespace Terminal {
+
+/// @brief Get the terminal size.
+/// @return The terminal size.
+/// @ingroup screen
+Dimensions Size() {
+  if (!g_size_caching) {
+    return ComputeSize();
+  }
+  if (!g_size_cached) {
+    g_cached_size = ComputeSize();
+    g_size_cached = true;
+  }
+  return g_cached_size;
+}
+
 /// @brief Override terminal size in case auto-detection fails
 /// @param fallbackSize Terminal dimensions to fallback to
 void SetFallbackSize(const Dimensions& fallbackSize) {
   FallbackSize() = fallbackSize;
+  InvalidateSize();
+}
+
+/// @brief Override how the terminal size is computed. This is useful for
+/// headless and test use.
+/// @param provider The function returning the terminal size. An empty function
+/// restores the default.
+/// @ingroup screen
+void SetSizeProvider(std::function<Dimensions()> provider) {
+  SizeProvider() = std::move(provider);
+  InvalidateSize();
+}
+
+/// @brief Set whether Size() caches the terminal size, instead of querying the
+/// terminal on every call. The cache must then be invalidated whenever the
+/// terminal is resized, using InvalidateSize().
+/// @note ScreenInteractive enables it while running, and invalidates it on
+/// SIGWINCH.
+/// @ingroup screen
+void SetSizeCaching(bool enable) {
+  g_size_caching = enable;
+  InvalidateSize();
+}
+
+/// @brief Invalidate the cached terminal size.
+/// @ingroup screen
+void InvalidateSize() {
+  g_size_cached = false;
 }
 
 /// @brief Get the color support of the terminal.
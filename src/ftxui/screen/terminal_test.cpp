@@ -0,0 +1,33 @@
+// Copyright 2024 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/screen/terminal.hpp"
+
+#include <gtest/gtest.h>
+
+namespace ftxui {
+
+TEST(TerminalTest, SizeProvider) {
+  int calls = 0;
+  Terminal::SetSizeProvider([&] {
+    ++calls;
+    return Dimensions{10 + calls, 20};
+  });
+
+  EXPECT_EQ(Terminal::Size().dimx, 11);
+  EXPECT_EQ(Terminal::Size().dimx, 12);
+
+  // Cached until invalidated.
+  Terminal::SetSizeCaching(true);
+  EXPECT_EQ(Terminal::Size().dimx, 13);
+  EXPECT_EQ(Terminal::Size().dimx, 13);
+  EXPECT_EQ(calls, 3);
+  Terminal::InvalidateSize();
+  EXPECT_EQ(Terminal::Size().dimx, 14);
+  EXPECT_EQ(Terminal::Size().dimy, 20);
+
+  Terminal::SetSizeCaching(false);
+  Terminal::SetSizeProvider(nullptr);
+}
+
+}  // namespace ftxui